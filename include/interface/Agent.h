@@ -17,6 +17,8 @@
 #include "EndMessage.h"
 #include "PrivateVariableStorage.h"
 #include "ThreadWrapper.h"
+#include <set>
+#include <vector>
 
 namespace pdesmas {
   class Agent : public ThreadWrapper {
@@ -31,6 +33,13 @@ namespace pdesmas {
     SendWriteMessageAndGetResponse(unsigned long pVariableId, T pValue, unsigned long pTime);
 
 
+    const MultiReadResponseMessage *
+    SendMultiReadMessageAndGetResponse(const set<unsigned long> &variable_ids, unsigned long timestamp);
+
+    template<typename T>
+    const MultiWriteResponseMessage *
+    SendMultiWriteMessageAndGetResponse(const map<unsigned long, T> &variable_values, unsigned long timestamp);
+
     const RangeQueryMessage *
     SendRangeQueryPointMessageAndGetResponse(unsigned long pTime, const Point pStartValue, const Point pEndValue);
 
@@ -86,6 +95,14 @@ namespace pdesmas {
     const SerialisableMap<SsvId, Value<Point> >
     RangeQueryPoint(const Point start, const Point end, unsigned long timestamp);
 
+    // Read several variables at one timestamp, with one message for every CLP holding some of them
+    template<typename T>
+    const map<unsigned long, T> ReadMany(const vector<unsigned long> &variable_ids, unsigned long timestamp);
+
+    // Write several variables at one timestamp, true if every write succeeded
+    template<typename T>
+    bool WriteMany(const map<unsigned long, T> &variable_values, unsigned long timestamp);
+
 
   public:
     Agent(unsigned long const start_time, unsigned long const end_time, unsigned long agent_id);
@@ -13,6 +13,8 @@
 #include "SingleReadMessage.h"
 #include "WriteMessage.h"
 #include "RangeQueryMessage.h"
+#include "MultiReadMessage.h"
+#include "MultiWriteMessage.h"
 
 namespace pdesmas {
   class HasSendList {
@@ -23,8 +25,13 @@ namespace pdesmas {
       void AddToSendList(const SingleReadMessage*);
       void AddToSendList(const WriteMessage*);
       void AddToSendList(const RangeQueryMessage*);
+      // Batches are kept as one read or write per variable, so a rollback cancels them variable by variable
+      void AddToSendList(const MultiReadMessage*);
+      void AddToSendList(const MultiWriteMessage*);
 
     bool RemoveFromSendList(unsigned long message_id);
+      // Remove the write of one variable of a batched write
+      bool RemoveFromSendList(unsigned long, const SsvId&);
       list<SharedStateMessage*> RollbackSendList(unsigned long, const LpId&);
       void ClearSendList(unsigned long);
   };
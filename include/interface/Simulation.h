@@ -58,6 +58,11 @@ private:
   unsigned long end_time_;
   map<int, DummyNode *> topology_;
   Initialisor *initialisor_;
+
+  void InitialiseMpi();
+
+  // Barrier over all LPs, before they have a transport of their own
+  void Barrier();
 public:
   Simulation();
 
@@ -65,6 +70,12 @@ public:
 
   void Construct(int number_of_clp, int number_of_alp, unsigned long start_time, unsigned long end_time);
 
+  /*
+   * Run the simulation program once per LP, each in a thread of this process with its own rank,
+   * instead of once per MPI process. Messages between the LPs are passed by pointer.
+   */
+  static int RunInProcess(int number_of_lp, int (*program)(int, char **), int argc, char **argv);
+
   void Initialise();
 
   Simulation &set_topology(const string &topo);
@@ -13,6 +13,8 @@
 #include "HasRollbackTagList.h"
 #include "SingleReadResponseMessage.h"
 #include "WriteResponseMessage.h"
+#include "MultiReadResponseMessage.h"
+#include "MultiWriteResponseMessage.h"
 #include <vector>
 #include <interface/IdentifierHandler.h>
 #include <PrivateVariableStorage.h>
@@ -27,6 +29,9 @@ namespace pdesmas {
     IdentifierHandler *message_id_handler_;
     map<unsigned long, const AbstractMessage *> agent_response_map_;
     map<unsigned long, unsigned long> agent_response_message_id_map_;
+    // Number of variables the batch an agent waits for covers, and the responses to it combined so far
+    map<unsigned long, unsigned long> agent_response_ssv_count_map_;
+    map<unsigned long, ResponseMessage *> agent_partial_response_map_;
     map<unsigned long, Mutex> agent_rollback_reentry_lock_map_;
     map<unsigned long, list<unsigned long> > agent_lvt_history_map_; // use this to perform LVT rollback
     map<unsigned long, PrivateVariableStorage> agent_local_variables_map_;
@@ -43,6 +48,11 @@ namespace pdesmas {
 
     void ProcessMessage(const WriteResponseMessage *);
 
+    // Batch responses are combined until every variable of the batch is answered
+    void ProcessMessage(MultiReadResponseMessage *);
+
+    void ProcessMessage(MultiWriteResponseMessage *);
+
     void ProcessMessage(const RangeQueryMessage *);
 
     bool SetAlpManagedAgentLvt(unsigned long agent_id, unsigned long newLvt);
@@ -93,7 +103,7 @@ namespace pdesmas {
 
     void SetGvt(unsigned long);
 
-    void Send() override;
+    bool Send() override;
 
     void Receive() override;
 
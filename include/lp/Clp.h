@@ -7,6 +7,8 @@
 #include "RollbackList.h"
 #include "WriteMessage.h"
 #include "SingleReadMessage.h"
+#include "MultiReadMessage.h"
+#include "MultiWriteMessage.h"
 #include "SsvId.h"
 #include "LpId.h"
 #include "AbstractValue.h"
@@ -16,6 +18,8 @@
 #include "RangeRoutingTable.h"
 #include "RangeUpdateMessage.h"
 #include "EndMessage.h"
+#include "ReceiveScheduler.h"
+#include "ClpShard.h"
 
 using namespace std;
 
@@ -27,21 +31,52 @@ namespace pdesmas {
   class Clp: public Lp {
     private:
       Router* fRouter;
+#ifdef CLP_SHARDS
+      // Shards of the shared state by SSV id, with the point bounds they share and the mutex guarding those, the
+      // local range routing table and the access cost calculator
+      vector<ClpShard*> fShards;
+      PointBounds fShardPointBounds;
+      Mutex fShardMutex;
+
+      ClpShard* GetShard(const SsvId&) const;
+      // Wait until the shards have processed every message handed to them
+      void WaitForShards();
+#else
       SharedState fSharedState;
+#endif
       bool fEndMessageProcessed;
 
       unsigned long GetLvt() const;
 
-      void ProcessMessage(const SingleReadMessage*);
-      void ProcessMessage(const SingleReadAntiMessage*);
-      void ProcessMessage(const WriteMessage*);
-      void ProcessMessage(const WriteAntiMessage*);
+      // The shared state holding the variable
+      SharedState& GetSharedState(const SsvId&);
+      // Process a read, write or anti-message for a variable of this CLP, in the shard of the variable if sharded
+      void ProcessSsvMessage(SimulationMessage*, const SsvId&);
+      void ProcessMessage(const SingleReadMessage*, SharedState&);
+      void ProcessMessage(const SingleReadAntiMessage*, SharedState&);
+      void ProcessMessage(const WriteMessage*, SharedState&);
+      void ProcessMessage(const WriteAntiMessage*, SharedState&);
+      // Forward the variables routed elsewhere, one message per direction, and process the rest at one timestamp
+      void ProcessMessage(const MultiReadMessage*);
+      void ProcessMessage(const MultiWriteMessage*);
       void ProcessMessage(const EndMessage*);
       void PostProcessMessage();
 
       void Initialise();
       void Finalise();
 
+#ifdef CLP_RECEIVE_SCHEDULER
+      // Shared state messages wait here to be processed in timestamp order
+      ReceiveScheduler fReceiveScheduler;
+      AbstractMessage* HoldReceivedMessages();
+      AbstractMessage* DequeueScheduledMessage();
+#endif
+
+#ifdef CLP_ANNIHILATION
+      // Account for the messages and anti-messages annihilated in the receive queue and delete them
+      void DropAnnihilatedMessages();
+#endif
+
 #ifdef SSV_LOCALISATION
       AccessCostCalculator* fAccessCostCalculator;
       bool fStopLoadBalanceProcessing;
@@ -55,6 +90,10 @@ namespace pdesmas {
       void ProcessMessage(const RangeQueryAntiMessage*);
       void ProcessMessage(const RangeUpdateMessage*);
       void SendRangeUpdates(const list<RangeUpdates>&, Direction);
+      // Send and clear the updates of the local range the shared state made
+      void SendLocalRangeUpdates();
+      // Points in the range at the time over all of the shared state
+      SerialisableMap<SsvId, Value<Point> > RangeRead(const Range&, Direction, unsigned long, unsigned long);
       void InitialisePortRanges(const Initialisor*);
 #endif
 
@@ -68,8 +107,10 @@ namespace pdesmas {
 
     map<unsigned long, list<unsigned long>> GetAgentTimeHistoryMap() const override;
 
-    void Send();
+    bool Send();
       void Receive();
+      // Process and delete a read, write or anti-message for a variable in the shared state, on its shard thread
+      void ProcessShardMessage(SimulationMessage*, SharedState&);
   };
 }
 #endif
@@ -0,0 +1,58 @@
+/*
+ * ClpShard.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Part of the shared state of a Clp, processed on a thread of its own. With
+ * CLP_SHARDS defined a Clp splits its variables over that many shards by SSV
+ * id, and hands the reads, writes and anti-messages it routes to itself to
+ * the shard of their variable. A shard processes its messages in the order
+ * they were handed over, so the messages for one variable keep their order
+ * while the shards work side by side. The Clp keeps routing and everything
+ * that spans variables, and waits for its shards to become idle first.
+ */
+
+#ifndef CLPSHARD_H_
+#define CLPSHARD_H_
+
+#include <deque>
+#include "Thread.h"
+#include "Mutex.h"
+#include "SharedState.h"
+#include "SimulationMessage.h"
+
+namespace pdesmas {
+  class Clp;
+
+  class ClpShard: public Thread {
+    private:
+      Clp* fClp;
+      SharedState fSharedState;
+      // Messages waiting to be processed, the shard owns them
+      std::deque<SimulationMessage*> fMessageQueue;
+      // Timestamp of the message taken from the queue, while it is processed
+      bool fIsProcessing;
+      unsigned long fProcessingTimestamp;
+      bool fIsRunning;
+      unsigned long fProcessedCount;
+      // Guards the members above, its condition is signalled when the shard becomes idle
+      mutable Mutex fMutex;
+
+    public:
+      ClpShard(Clp*);
+
+      SharedState& GetSharedState();
+      void QueueMessage(SimulationMessage*);
+      // Block until every message handed over has been processed
+      void WaitUntilIdle();
+      // Lowest timestamp of the messages queued or being processed, ULONG_MAX if there are none
+      unsigned long GetMinimumTimestamp() const;
+      unsigned long GetProcessedCount() const;
+      // Process the messages still queued and end the thread
+      void StopProcessing();
+
+      void* MyThread(void*);
+  };
+}
+
+#endif /* CLPSHARD_H_ */
@@ -23,7 +23,7 @@
 #include "MessageQueue.h"
 #include "GvtCalculator.h"
 #include "LpId.h"
-#include "MpiInterface.h"
+#include "Transport.h"
 #include <deque>
 #include "Router.h"
 #include "Mutex.h"
@@ -49,10 +49,14 @@ namespace pdesmas {
 
       void PreProcessSendMessage(SimulationMessage*);
       void PreProcessReceiveMessage(const SimulationMessage*);
+      // Log the number of messages and queue depths of every receive lane
+      void LogReceiveQueueStatistics() const;
 
     public:
-      // Normal receive queue for simulation and control messages
+      // Normal receive queue for simulation messages
       MessageQueue* fReceiveMessageQueue;
+      // Receive queue for control messages, taken before simulation messages
+      MessageQueue* fReceiveControlMessageQueue;
       // Send queue for simulation messages. Messages in this queue are blocked by the window if a windowing mechanism is used
       MessageQueue* fSendMessageQueue;
       // For control messages - Non blocking even with windows
@@ -61,17 +65,18 @@ namespace pdesmas {
       MessageQueue* fReceiveLoadBalancingMessageQueue;
       // Send queue for load balancing messages
       MessageQueue* fSendLoadBalancingMessageQueue;
-      // Class which provides the interface from the Lp to MPI. If a different message passing system is required this class should be redefined (eg., PVM_Interface)
-      MpiInterface* fMPIInterface;
+      // Interface from the Lp to the message passing system, MPI or in process (see Transport.h)
+      Transport* fTransport;
 
       // Default constructor
       Lp();
       // Default deconstructor
       ~Lp();
       /* Virtual method indicating how messages are transferred from the
-       sendQ's of the Lp to the MpiInterface. This method is purely
+       sendQ's of the Lp to the Transport. Returns false if there
+       was no message left to send. This method is purely
        virtual for Lp and must be redefined for any subclass */
-      virtual void Send()=0;
+      virtual bool Send()=0;
       /* Virtual method indicating how messages are taken from recvQ and
        passed to ProcessMessage method. This has no definition in Lp, so
        it must be redefined for sub classes. */
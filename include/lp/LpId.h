@@ -51,6 +51,8 @@ namespace pdesmas {
 
       void Serialise(ostream& ostr) const;
       void Deserialise(istream& istr);
+      void Pack(WireWriter& pWriter) const;
+      void Unpack(WireReader& pReader);
   };
 
 }
@@ -1,26 +1,99 @@
 #ifndef _MESSAGEQUEUE_H_
 #define _MESSAGEQUEUE_H_
 
+#include <atomic>
 #include <deque>
+#include <map>
 #include "AbstractMessage.h"
 #include "Mutex.h"
 #include "LpId.h"
+#include "ObjectPool.h"
 
 using namespace std;
 
+/*
+ * Multi-producer, single-consumer message queue. Producers push onto a
+ * lock-free linked inbox. The consumer moves everything that arrived in the
+ * inbox onto its own deque in one pass, under a mutex that only the
+ * consumer side takes, so producers never wait for each other or for the
+ * consumer. RemoveMessages takes the consumer side as well.
+ *
+ * Removed messages leave an empty entry in the deque until it reaches the
+ * front. An indexed queue also keeps the pending shared state messages of
+ * every original agent by timestamp, so RemoveMessages only visits the
+ * messages it may remove.
+ *
+ * An annihilating queue drops a read, write or range query together with
+ * its anti-message when the anti-message arrives over the same link while
+ * the message is still queued. The dropped pairs are handed to the consumer
+ * through DequeueAnnihilatedMessage, which still has to account for them
+ * as received.
+ */
 namespace pdesmas {
   class MessageQueue {
     private:
+      struct Node: public Pooled<Node> {
+        atomic<Node*> fNext;
+        AbstractMessage* fMessage;
+      };
+      // Last node pushed, producers only
+      atomic<Node*> fInboxTail;
+      // Node taken last, its successors are waiting in the inbox
+      Node* fInboxHead;
+
+      // Messages in queue order, NULL where a message was removed
       deque<AbstractMessage*> fMessageQueue;
+      // Sequence number of the front entry, every entry has the next number of the one before it
+      unsigned long fFrontSequence;
+      // Entries in fMessageQueue still holding a message
+      size_t fMessageCount;
+      // Timestamp to sequence number of the pending shared state messages, per original agent rank and id
+      // (LpId::operator< does not order agents strictly)
+      bool fIsIndexed;
+      map<pair<unsigned int, unsigned long>, multimap<unsigned long, unsigned long> > fAgentIndex;
+      bool fIsAnnihilating;
+      // Messages and anti-messages annihilated but not yet taken by the consumer
+      deque<AbstractMessage*> fAnnihilatedMessages;
+      unsigned long fAnnihilatedCount;
       mutable Mutex fMutex;
+      // Depth statistics, sampled whenever a message is moved from the inbox
+      unsigned long fQueuedCount;
+      unsigned long fDepthSum;
+      unsigned long fPeakSize;
+
+      void TakeInbox();
+      void AddToIndex(const AbstractMessage*, unsigned long);
+      void RemoveFromIndex(const AbstractMessage*, unsigned long);
+      // Delete the message of an entry and leave the entry empty
+      void RemoveEntry(deque<AbstractMessage*>::iterator);
+      // Original agent and timestamp of a read, write or range query, false for other messages
+      static bool GetIndexKey(const AbstractMessage*, LpId&, unsigned long&);
+      // Drop a queued message with its anti-message, false if no queued message matches
+      bool Annihilate(AbstractMessage*);
+      static bool IsAnnihilatedBy(const AbstractMessage*, const AbstractMessage*);
+      static bool IsCancelled(const AbstractMessage*, const LpId&, unsigned long);
     public:
-      MessageQueue();
+      MessageQueue(bool pIsIndexed = false);
       ~MessageQueue();
 
       bool IsEmpty() const;
       void QueueMessage(AbstractMessage*);
+      // Returns NULL if the queue is empty
       AbstractMessage* DequeueMessage();
+      // Returns NULL if no annihilated message is left
+      AbstractMessage* DequeueAnnihilatedMessage();
+      // Annihilate received anti-messages with their messages, call before the queue is used
+      void EnableAnnihilation();
+      // Remove the reads, writes and range queries of an original agent from a time on
       void RemoveMessages(const LpId&, unsigned long);
+
+      // Number of message and anti-message pairs annihilated
+      unsigned long GetAnnihilatedCount() const;
+      // Number of messages taken from the inbox since construction
+      unsigned long GetQueuedCount() const;
+      // Largest and mean number of messages in the queue after taking one from the inbox
+      unsigned long GetPeakSize() const;
+      double GetMeanDepth() const;
   };
 }
 #endif
@@ -8,9 +8,9 @@
  Date: 01/04/2005
 
  This class provides the interface between LPs and the MPI
- communication infrastructure. At present a single MpiInterface (one
- thread) is used for both sending and receiving messages. Eventually
- with MPI_THREAD_MULTIPLE support this will change.
+ communication infrastructure, it is the Transport of LPs running as
+ separate MPI processes. At present a single MpiInterface (one
+ thread) is used for both sending and receiving messages.
 
  Revisions: 30/08/05 - mhl - After some work with assk it was
  discovered the old single thread design is actually unsafe. To remedy
@@ -18,6 +18,14 @@
  are separated into two threads, with all MPI calls being locked by a
  mutex. This involves two new classes SendThread and ReceiveThread
 
+ If MPI provides MPI_THREAD_MULTIPLE the mutex is dropped, the send and
+ receive threads then only lock against their own callers. Messages go
+ over a communicator duplicated from MPI_COMM_WORLD, apart from the
+ barriers in the Lps.
+
+ With SHARED_MEMORY_TRANSPORT, messages between ranks on the same node
+ bypass MPI and go through a SharedMemoryTransport.
+
  */
 #ifndef _MPIINTERFACE_H_
 #define _MPIINTERFACE_H_
@@ -27,13 +35,41 @@
 #include "AbstractMessage.h"
 #include "Semaphore.h"
 #include "Mutex.h"
+#include "Transport.h"
+
+/*
+ * Point to point tags, offset by the MessageLane of the messages. Messages
+ * that do not fit in a receive slot are announced by a frame on
+ * MPI_TAG_MESSAGE, the message itself follows on MPI_TAG_LARGE_MESSAGE of
+ * the same lane from the same sender.
+ */
+#define MPI_TAG_MESSAGE 0
+#define MPI_TAG_LARGE_MESSAGE LANE_SIZE
+// Largest message received directly into a pre-posted receive slot
+#define RECEIVE_SLOT_SIZE 4096
+// Large message frame: marker byte followed by the message length
+#define LARGE_MESSAGE_MARKER '\xff'
+#define LARGE_MESSAGE_FRAME_SIZE (1 + sizeof(unsigned int))
+/*
+ * Envelope of coalesced messages for one destination: marker byte and
+ * message count, followed by every message prefixed with its length
+ */
+#define ENVELOPE_MARKER '\xfe'
+#define ENVELOPE_HEADER_SIZE (1 + sizeof(unsigned int))
 
 namespace pdesmas {
   class SendThread;
   class ReceiveThread;
-  class MpiInterface {
+  class SharedMemoryTransport;
+  class MpiInterface: public Transport {
     private:
       Mutex fMutex;
+      // Guards the send pipeline when there is no global MPI mutex
+      Mutex fSendMutex;
+      bool fIsThreadMultiple;
+      MPI_Comm fCommunicator;
+      // Transport to ranks on the same node, nullptr if disabled or no rank shares the node
+      SharedMemoryTransport* fSharedMemoryTransport;
 
       SendThread* sendThread; /**< The thread used for sending messages to MPI */
       ReceiveThread* receiveThread; /**< Thread used for receiving messages from MPI */
@@ -51,14 +87,28 @@ namespace pdesmas {
       void Stop();
 
       void Send(AbstractMessage* sendMsg);
+      // Flushes the send pipeline, then waits for all ranks on MPI_COMM_WORLD
+      void Barrier();
+      // Send all envelopes still being collected, the send mutex must be held
+      void FlushSends();
 
       void ReceiveWait();
       void SendWait();
+      bool SendWait(unsigned long);
+      bool SendTryWait();
       void ReceiveSignal();
       void SendSignal();
 
+      // Global MPI mutex, does nothing with MPI_THREAD_MULTIPLE
       int LockMpi();
       int UnlockMpi();
+      // Mutex for the send pipeline, the global MPI mutex unless MPI_THREAD_MULTIPLE
+      int LockSend();
+      int UnlockSend();
+
+      bool IsThreadMultiple() const;
+      MPI_Comm GetCommunicator() const;
+      SharedMemoryTransport* GetSharedMemoryTransport() const;
   };
 }
 #endif
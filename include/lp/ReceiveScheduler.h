@@ -0,0 +1,69 @@
+/*
+ * ReceiveScheduler.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Timestamp ordered hold back of the shared state messages received by a
+ * Clp. Reads and writes, batched or not, range queries and their
+ * anti-messages are held
+ * in a binary heap and released lowest timestamp first. Ties go in arrival
+ * order, so an anti-message stays behind the message it cancels. The lowest
+ * timestamp message is held until it has waited CLP_RECEIVE_SCHEDULER_DELAY
+ * microseconds, which gives an older write still underway the chance to
+ * overtake newer reads instead of rolling them back.
+ */
+
+#ifndef RECEIVESCHEDULER_H_
+#define RECEIVESCHEDULER_H_
+
+#include <queue>
+#include <set>
+#include <vector>
+#include "SimulationMessage.h"
+
+// Microseconds the lowest timestamp message waits for older messages to arrive
+#ifndef CLP_RECEIVE_SCHEDULER_DELAY
+#define CLP_RECEIVE_SCHEDULER_DELAY 0
+#endif
+
+namespace pdesmas {
+  class ReceiveScheduler {
+    private:
+      struct HeldMessage {
+        unsigned long fTimestamp;
+        unsigned long fSequence;
+        unsigned long fArrivalTime;
+        SimulationMessage* fMessage;
+      };
+      // Orders the heap lowest timestamp first, then in arrival order
+      struct IsLater {
+        bool operator()(const HeldMessage&, const HeldMessage&) const;
+      };
+      std::priority_queue<HeldMessage, std::vector<HeldMessage>, IsLater> fHeldMessages;
+      // Arrival sequence numbers of the held messages
+      std::set<unsigned long> fHeldSequences;
+      unsigned long fSequence;
+      unsigned long fReorderedCount;
+
+    public:
+      ReceiveScheduler();
+      ~ReceiveScheduler();
+
+      // True for the message types held back by the scheduler
+      static bool IsScheduled(const AbstractMessage*);
+
+      void Hold(SimulationMessage*);
+      bool IsEmpty() const;
+      // Microseconds until the lowest timestamp message is due, 0 if it is due now
+      unsigned long GetWaitTime() const;
+      // Returns the lowest timestamp message, NULL if none is held
+      SimulationMessage* Release();
+
+      // Number of messages held so far
+      unsigned long GetHeldCount() const;
+      // Number of messages released ahead of a message that arrived earlier
+      unsigned long GetReorderedCount() const;
+  };
+}
+
+#endif /* RECEIVESCHEDULER_H_ */
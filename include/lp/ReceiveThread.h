@@ -2,9 +2,14 @@
 #define _RECEIVETHREAD_H_
 
 #include <mpi.h>
+#include <vector>
 #include "LpId.h"
 #include "AbstractMessage.h"
 #include "Thread.h"
+#include "Backoff.h"
+
+// Number of receives kept posted ahead of message arrival, per lane
+#define RECEIVE_RING_SIZE 32
 
 namespace pdesmas {
   class ReceiveThread: public Thread {
@@ -12,10 +17,33 @@ namespace pdesmas {
       Lp* fLp;
       MpiInterface* fMPIInterface;
       bool fIsSimulationRunning;
+
+      /*
+       * Rings of receives posted on fixed size slot buffers, one ring of
+       * RECEIVE_RING_SIZE slots per MessageLane. Incoming messages match the
+       * oldest posted receive of their lane, so the slots of a lane are
+       * handled from its ring head onwards to keep messages from the same
+       * sender in order. Lanes are handled highest priority first.
+       */
+      MPI_Request fRequests[LANE_SIZE * RECEIVE_RING_SIZE];
+      MPI_Status fStatuses[LANE_SIZE * RECEIVE_RING_SIZE];
+      char* fSlotBuffers[LANE_SIZE * RECEIVE_RING_SIZE];
+      int fRingHeads[LANE_SIZE];
+      // Buffer for messages larger than a slot, grows in power of two sizes
+      std::vector<char> fLargeBuffer;
+      // Envelope taken from shared memory
+      std::vector<char> fSharedBuffer;
+      // Idle strategy between empty polls, also books time spent working and idling
+      Backoff fBackoff;
+
+      void PostReceive(int);
+      void CancelReceives();
+      const char* ReceiveLarge(const char*, const MPI_Status&, int&);
+      AbstractMessage* Decode(const char*, int) const;
+      void DecodeEnvelope(const char*, int, std::vector<AbstractMessage*>&) const;
     public:
       ReceiveThread(Lp*, MpiInterface*);
       ~ReceiveThread();
-      AbstractMessage* Receive(MPI_Status*) const;
       void* MyThread(void*);
       void StopSimulation();
   };
@@ -1,6 +1,8 @@
 #ifndef _ROLLBACKLIST_H_
 #define _ROLLBACKLIST_H_
 
+#include <map>
+
 using namespace std;
 
 #include "LpId.h"
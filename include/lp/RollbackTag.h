@@ -79,6 +79,10 @@ public:
      part of a RollbackMessage */
   void Deserialise(std::istream &);
   /**< Method which deserialises the rollback tag after sending */
+  void Pack(WireWriter &) const;
+  /**< Packs the rollback tag into the binary wire format */
+  void Unpack(WireReader &);
+  /**< Unpacks the rollback tag from the binary wire format */
 
   
 };
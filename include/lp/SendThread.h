@@ -2,9 +2,34 @@
 #define _SENDTHREAD_H_
 
 #include <mpi.h>
+#include <map>
+#include <vector>
 #include "LpId.h"
 #include "AbstractMessage.h"
 #include "Thread.h"
+#include "Backoff.h"
+#include "MpiInterface.h"
+
+// Maximum number of sends in flight, and per destination rank
+#define SEND_PIPELINE_SIZE 64
+#define SEND_WINDOW_SIZE 16
+// Maximum number of messages taken from the Lp send queues per wakeup
+#define SEND_BATCH_SIZE 64
+// Microseconds between completion tests while sends are in flight and nothing is queued
+#define SEND_POLL_INTERVAL 200
+/*
+ * Coalescing budget. Messages for the same destination and lane are
+ * collected in one envelope until it holds COALESCE_MAX_BYTES, or until the
+ * send queues are drained and the oldest message has waited
+ * COALESCE_MAX_DELAY microseconds. Envelopes of the control and load
+ * balancing lanes are sent as soon as a message is added.
+ */
+#ifndef COALESCE_MAX_BYTES
+#define COALESCE_MAX_BYTES RECEIVE_SLOT_SIZE
+#endif
+#ifndef COALESCE_MAX_DELAY
+#define COALESCE_MAX_DELAY 0
+#endif
 
 namespace pdesmas {
   class SendThread: public Thread {
@@ -13,14 +38,54 @@ namespace pdesmas {
       Lp* fLp;
       MpiInterface* fMPIInterface;
 
+      /*
+       * Send slot, collects the envelope for one destination and lane and
+       * holds it until its send completes. A large message uses both requests of its
+       * slot, see MpiInterface.h. Envelopes for ranks on the same node are
+       * written to shared memory from fSendOffset, fSharedWritten bytes so far.
+       */
+      struct SendSlot {
+        int fDestination;
+        MessageLane fLane;
+        bool fIsSending;
+        unsigned int fMessageCount;
+        unsigned long fFirstMessageTime;
+        WireWriter fBuffer;
+        char fLargeMessageFrame[LARGE_MESSAGE_FRAME_SIZE];
+        size_t fSendOffset;
+        size_t fSharedWritten;
+      };
+      SendSlot fSlots[SEND_PIPELINE_SIZE];
+      MPI_Request fRequests[2 * SEND_PIPELINE_SIZE];
+      std::vector<int> fFreeSlots;
+      std::map<int, unsigned int> fOutstandingSends;
+      // Slots being written to shared memory, in flush order
+      std::vector<int> fSharedSends;
+      // Slot of the envelope being collected for each destination and lane, see GetEnvelopeKey
+      std::map<int, int> fOpenSlots;
+      unsigned int fOutstandingCount;
+      // Idle strategy while waiting for sends to complete, time blocked on the send semaphore is not booked
+      Backoff fBackoff;
+      // Encoded message before it is appended to an envelope
+      WireWriter fEncodeBuffer;
+
+      static int GetEnvelopeKey(int, MessageLane);
+      int OpenSlot(int, MessageLane);
+      void Flush(int);
+      void FlushAged(bool);
+      void ReleaseSlot(int);
+      int CompleteMpiSends();
+      int CompleteSharedSends();
+      void CompleteSends(bool);
+
     public:
       SendThread(Lp*, MpiInterface*);
       ~SendThread();
 
       void Send(AbstractMessage*);
+      void FlushAll();
       void* MyThread(void*);
       void StopSimulation();
   };
 }
 #endif
-
@@ -0,0 +1,84 @@
+/*
+ * SharedMemoryTransport.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Message transport between ranks on the same node. Every rank allocates one
+ * single-producer/single-consumer ring per rank on its node in an MPI shared
+ * memory window, and reads the messages written to it from there. A ring is a
+ * byte stream of messages prefixed with their length, so messages of any size
+ * pass through in pieces as the reader frees space. Ranks on other nodes keep
+ * using MPI point to point messages.
+ */
+
+#ifndef SHAREDMEMORYTRANSPORT_H_
+#define SHAREDMEMORYTRANSPORT_H_
+
+#include <mpi.h>
+#include <atomic>
+#include <vector>
+
+// Bytes per ring, a power of two
+#ifndef SHARED_RING_SIZE
+#define SHARED_RING_SIZE (1 << 18)
+#endif
+#define SHARED_CACHE_LINE_SIZE 64
+
+namespace pdesmas {
+  /*
+   * Ring in shared memory. fTail is only written by the sending rank, fHead
+   * only by the receiving rank, both count bytes since the start.
+   */
+  struct SharedRing {
+    alignas(SHARED_CACHE_LINE_SIZE) std::atomic<unsigned long> fHead;
+    alignas(SHARED_CACHE_LINE_SIZE) std::atomic<unsigned long> fTail;
+    alignas(SHARED_CACHE_LINE_SIZE) char fData[SHARED_RING_SIZE];
+  };
+
+  class SharedMemoryTransport {
+    private:
+      MPI_Comm fNodeCommunicator;
+      MPI_Win fWindow;
+      int fNodeRank;
+      int fNodeSize;
+      // Node rank for every rank of the message communicator, -1 for ranks on other nodes
+      std::vector<int> fNodeRanks;
+      // Rings written by this rank, indexed by node rank of the receiver
+      std::vector<SharedRing*> fOutboundRings;
+      // Rings read by this rank, indexed by node rank of the sender
+      std::vector<SharedRing*> fInboundRings;
+
+      // Message being read from an inbound ring
+      struct PendingMessage {
+        bool fHasLength;
+        unsigned int fLength;
+        unsigned int fReceived;
+        std::vector<char> fBuffer;
+      };
+      std::vector<PendingMessage> fPendingMessages;
+      // Inbound ring to read from first, taken in turn so no sender is starved
+      int fNextRing;
+
+      static void CopyIn(SharedRing*, unsigned long, const char*, size_t);
+      static void CopyOut(const SharedRing*, unsigned long, char*, size_t);
+    public:
+      // Collective over pCommunicator
+      SharedMemoryTransport(MPI_Comm);
+      ~SharedMemoryTransport();
+
+      // Whether messages to the rank go through shared memory
+      bool IsLocal(int) const;
+      // Whether any other rank shares the node
+      bool HasLocalRanks() const;
+      /*
+       * Write a message to the ring of the destination rank as far as space
+       * allows. pWritten keeps the progress across calls and starts at 0,
+       * returns true once the whole message is written.
+       */
+      bool Send(int, const char*, size_t, size_t&);
+      // Take the next complete message from any inbound ring, returns false if there is none
+      bool Receive(std::vector<char>&);
+  };
+}
+
+#endif /* SHAREDMEMORYTRANSPORT_H_ */
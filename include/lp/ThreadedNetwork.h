@@ -0,0 +1,62 @@
+/*
+ * ThreadedNetwork.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Runs all LPs of a simulation as threads of a single process. Every thread
+ * runs the simulation program with its own rank, as an MPI process would,
+ * and the LPs exchange messages through a ThreadedTransport each.
+ */
+
+#ifndef THREADEDNETWORK_H_
+#define THREADEDNETWORK_H_
+
+#include <pthread.h>
+#include <vector>
+
+namespace pdesmas {
+  class ThreadedTransport;
+  class ThreadedNetwork {
+    private:
+      static ThreadedNetwork* fInstance;
+      // Rank of the LP the calling thread runs
+      static thread_local int fThreadRank;
+
+      unsigned int fSize;
+      int (*fMain)(int, char**);
+      int fArgc;
+      char** fArgv;
+      std::vector<ThreadedTransport*> fTransports;
+      std::vector<int> fReturnValues;
+      pthread_barrier_t fBarrier;
+
+      struct LpThread {
+        ThreadedNetwork* fNetwork;
+        unsigned int fRank;
+        pthread_t fThreadID;
+      };
+      static void* RunLp(void*);
+
+      ThreadedNetwork(unsigned int, int (*)(int, char**), int, char**);
+    public:
+      ~ThreadedNetwork();
+
+      /*
+       * Run pMain in pSize threads, one per LP, and wait for all of them.
+       * Returns the first non-zero return value, or zero.
+       */
+      static int Run(unsigned int, int (*)(int, char**), int, char**);
+      // The running network, nullptr outside ThreadedNetwork::Run
+      static ThreadedNetwork* GetInstance();
+
+      unsigned int GetSize() const;
+      // Rank of the LP of the calling thread
+      unsigned int GetRank() const;
+      void Barrier();
+
+      void AddTransport(unsigned int, ThreadedTransport*);
+      ThreadedTransport* GetTransport(unsigned int) const;
+  };
+}
+
+#endif /* THREADEDNETWORK_H_ */
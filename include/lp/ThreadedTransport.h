@@ -0,0 +1,57 @@
+/*
+ * ThreadedTransport.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Transport between LPs running as threads of one process, see
+ * ThreadedNetwork. Sent messages are handed to the destination by pointer
+ * without serialisation: they go into its inbox and are moved onto its
+ * receive queues when its Lp waits for a message. Like SendThread, a
+ * thread takes messages off the Lp send queues.
+ */
+
+#ifndef THREADEDTRANSPORT_H_
+#define THREADEDTRANSPORT_H_
+
+#include <vector>
+#include "Transport.h"
+#include "Thread.h"
+#include "Mutex.h"
+#include "Semaphore.h"
+
+namespace pdesmas {
+  class ThreadedNetwork;
+  class ThreadedTransport: public Thread, public Transport {
+    private:
+      Lp* fLp;
+      ThreadedNetwork* fNetwork;
+      bool fIsSimulationRunning;
+
+      // Messages handed over by other LPs, not yet on the receive queues
+      Mutex fInboxMutex;
+      std::vector<AbstractMessage*> fInbox;
+      std::vector<AbstractMessage*> fReceivedMessages;
+
+      Semaphore fSendSemaphore;
+      Semaphore fReceiveSemaphore;
+
+    public:
+      ThreadedTransport(Lp*, ThreadedNetwork*);
+      ~ThreadedTransport();
+
+      void* MyThread(void*);
+      // Take over a message sent by another LP
+      void Deliver(AbstractMessage*);
+
+      void Signal();
+      void StopSimulation();
+      void Join();
+      void Stop();
+      void Send(AbstractMessage*);
+      void ReceiveWait();
+      void SendSignal();
+      void Barrier();
+  };
+}
+
+#endif /* THREADEDTRANSPORT_H_ */
@@ -0,0 +1,44 @@
+/*
+ * Transport.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Interface between an Lp and the message passing layer underneath it.
+ * MpiInterface passes messages between processes over MPI,
+ * ThreadedTransport hands them over by pointer to LPs running as threads
+ * of the same process.
+ */
+
+#ifndef TRANSPORT_H_
+#define TRANSPORT_H_
+
+#include "AbstractMessage.h"
+
+namespace pdesmas {
+  class Lp;
+  class Transport {
+    public:
+      virtual ~Transport() {
+      }
+
+      // Transport for the Lp: in process when running in a ThreadedNetwork, MPI otherwise
+      static Transport* Create(Lp*);
+
+      // Start sending and receiving once all Lps are constructed
+      virtual void Signal() = 0;
+      virtual void StopSimulation() = 0;
+      virtual void Join() = 0;
+      virtual void Stop() = 0;
+
+      // Send the message to its destination, the transport takes ownership of it
+      virtual void Send(AbstractMessage*) = 0;
+      // Wait until a received message has been put on the Lp receive queues
+      virtual void ReceiveWait() = 0;
+      // A message is waiting in the Lp send queues
+      virtual void SendSignal() = 0;
+      // Wait for all Lps, messages sent before are on their way when it returns
+      virtual void Barrier() = 0;
+  };
+}
+
+#endif /* TRANSPORT_H_ */
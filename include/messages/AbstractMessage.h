@@ -22,6 +22,8 @@
 #include "HasOrigin.h"
 #include "HasDestination.h"
 #include "Types.h"
+#include "MatternColour.h"
+#include "MessageLane.h"
 
 using namespace std;
 
@@ -44,6 +46,14 @@ namespace pdesmas {
        * the create instance function pointer
        */
       static AbstractMessage* RecreateInstance(pdesmasType);
+      /*
+       * Timestamp and Mattern colour carried in the fixed binary header.
+       * Messages without them leave the defaults (0 and WHITE).
+       */
+      virtual unsigned long GetWireTimestamp() const;
+      virtual void SetWireTimestamp(unsigned long);
+      virtual MatternColour GetWireColour() const;
+      virtual void SetWireColour(MatternColour);
 
     public:
       AbstractMessage();
@@ -63,6 +73,11 @@ namespace pdesmas {
        * and SimulationMessage to use the three different receive queues.
        */
       virtual void ReceiveToLp(Lp *) const=0;
+      /*
+       * Priority lane of the message on the wire, also implemented in
+       * ControlMessage, LoadBalancingMessage and SimulationMessage.
+       */
+      virtual MessageLane GetLane() const=0;
       /*
        * Virtual Serialise method for serialising the message
        */
@@ -71,6 +86,21 @@ namespace pdesmas {
        * Virtual Deserialise method for deserialising the message
        */
       virtual void Deserialise(istream&)=0;
+      /*
+       * Pack the message in the binary wire format: a fixed header (format
+       * version, type, origin, destination, timestamp, colour), followed by
+       * the length-prefixed payload written by PackPayload
+       */
+      void Pack(WireWriter&) const;
+      /*
+       * Unpack a message packed by Pack, exits on a version or type mismatch
+       */
+      void Unpack(WireReader&);
+      /*
+       * Virtual methods for packing the fields following the fixed header
+       */
+      virtual void PackPayload(WireWriter&) const=0;
+      virtual void UnpackPayload(WireReader&)=0;
   };
 }
 #endif
@@ -17,6 +17,7 @@ namespace pdesmas {
 
       void SendToLp(Lp *pLp) const;
       void ReceiveToLp(Lp *pLp) const;
+      MessageLane GetLane() const;
   };
 }
 #endif
@@ -31,9 +31,10 @@
 
 #include "ControlMessage.h"
 #include "HasSenderAlp.h"
+#include "ObjectPool.h"
 
 namespace pdesmas {
-  class EndMessage: public ControlMessage, public HasSenderAlp {
+  class EndMessage: public ControlMessage, public HasSenderAlp, public Pooled<EndMessage> {
     private:
       static AbstractMessage* CreateInstance();
 
@@ -45,6 +46,8 @@ namespace pdesmas {
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
   };
 }
 #endif
@@ -7,6 +7,7 @@
 #include "HasMatternCut.h"
 #include "HasMessageCount.h"
 #include "HasAgentTimeHistoryRecord.h"
+#include "ObjectPool.h"
 
 namespace pdesmas {
   class GvtControlMessage : public GvtMessage,
@@ -14,7 +15,8 @@ namespace pdesmas {
                             public HasRedMessageTime,
                             public HasMatternCut,
                             public HasMessageCount,
-                            public HasAgentTimeHistoryRecord {
+                            public HasAgentTimeHistoryRecord,
+                            public Pooled<GvtControlMessage> {
   private:
     static AbstractMessage *CreateInstance();
 
@@ -27,6 +29,8 @@ namespace pdesmas {
 
     void Serialise(ostream &) const;
       void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
   };
 }
 #endif
@@ -2,9 +2,10 @@
 #define GVTREQUESTMESSAGE_H_
 
 #include "GvtMessage.h"
+#include "ObjectPool.h"
 
 namespace pdesmas {
-  class GvtRequestMessage: public GvtMessage {
+  class GvtRequestMessage: public GvtMessage, public Pooled<GvtRequestMessage> {
     private:
       static AbstractMessage* CreateInstance();
 
@@ -16,6 +17,8 @@ namespace pdesmas {
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
   };
 }
 #endif
@@ -3,9 +3,10 @@
 
 #include "GvtMessage.h"
 #include "HasGVT.h"
+#include "ObjectPool.h"
 
 namespace pdesmas {
-  class GvtValueMessage: public GvtMessage, public HasGVT {
+  class GvtValueMessage: public GvtMessage, public HasGVT, public Pooled<GvtValueMessage> {
     private:
       static AbstractMessage* CreateInstance();
 
@@ -17,6 +18,8 @@ namespace pdesmas {
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
   };
 }
 #endif
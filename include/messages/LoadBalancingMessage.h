@@ -11,6 +11,7 @@ namespace pdesmas {
 
       void SendToLp(Lp *) const;
       void ReceiveToLp(Lp *) const;
+      MessageLane GetLane() const;
   };
 }
 #endif
@@ -0,0 +1,35 @@
+  /*!
+   \brief Class for reading several SSVs at once
+
+   An instance of MultiReadMessage defines a message for an ALP reading the
+   values of several Shared State Variables at one timestamp. A CLP answers
+   the variables it holds with one MultiReadResponseMessage and forwards the
+   rest, one MultiReadMessage for every direction they are routed in.
+   */
+#ifndef MULTIREADMESSAGE_H_
+#define MULTIREADMESSAGE_H_
+
+#include "SharedStateMessage.h"
+#include "HasSSVIDList.h"
+#include "ObjectPool.h"
+
+namespace pdesmas {
+  class MultiReadMessage: public SharedStateMessage,
+    public HasSSVIDList,
+    public Pooled<MultiReadMessage> {
+    private:
+      static AbstractMessage* CreateInstance();
+
+    public:
+      MultiReadMessage();
+      virtual ~MultiReadMessage();
+
+      pdesmasType GetType() const;
+
+      void Serialise(ostream&) const;
+      void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
+  };
+}
+#endif
@@ -0,0 +1,28 @@
+#ifndef MULTIREADRESPONSEMESSAGE_H_
+#define MULTIREADRESPONSEMESSAGE_H_
+
+#include "ResponseMessage.h"
+#include "HasSSVIDValueList.h"
+#include "MultiReadMessage.h"
+#include "ObjectPool.h"
+
+namespace pdesmas {
+  class MultiReadResponseMessage: public ResponseMessage,
+      public HasSSVIDValueList,
+      public Pooled<MultiReadResponseMessage> {
+    private:
+      static AbstractMessage* CreateInstance();
+
+    public:
+      MultiReadResponseMessage();
+      virtual ~MultiReadResponseMessage();
+
+      pdesmasType GetType() const;
+
+      void Serialise(ostream&) const;
+      void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
+  };
+}
+#endif
@@ -0,0 +1,36 @@
+  /*!
+   \brief Class for updating several SSVs at once
+
+   An instance of MultiWriteMessage defines a message for an ALP updating
+   the values of several Shared State Variables at one timestamp. A CLP
+   writes the variables it holds and answers them with one
+   MultiWriteResponseMessage, and forwards the rest, one MultiWriteMessage
+   for every direction they are routed in.
+   */
+#ifndef MULTIWRITEMESSAGE_H_
+#define MULTIWRITEMESSAGE_H_
+
+#include "SharedStateMessage.h"
+#include "HasSSVIDValueList.h"
+#include "ObjectPool.h"
+
+namespace pdesmas {
+  class MultiWriteMessage: public SharedStateMessage,
+      public HasSSVIDValueList,
+      public Pooled<MultiWriteMessage> {
+    private:
+      static AbstractMessage* CreateInstance();
+
+    public:
+      MultiWriteMessage();
+      virtual ~MultiWriteMessage();
+
+      pdesmasType GetType() const;
+
+      void Serialise(ostream&) const;
+      void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
+  };
+}
+#endif
@@ -0,0 +1,28 @@
+#ifndef MULTIWRITERESPONSEMESSAGE_H_
+#define MULTIWRITERESPONSEMESSAGE_H_
+
+#include "ResponseMessage.h"
+#include "HasSSVIDWriteStatusMap.h"
+#include "MultiWriteMessage.h"
+#include "ObjectPool.h"
+
+namespace pdesmas {
+  class MultiWriteResponseMessage: public ResponseMessage,
+      public HasSSVIDWriteStatusMap,
+      public Pooled<MultiWriteResponseMessage> {
+    private:
+      static AbstractMessage* CreateInstance();
+
+    public:
+      MultiWriteResponseMessage();
+      virtual ~MultiWriteResponseMessage();
+
+      pdesmasType GetType() const;
+
+      void Serialise(ostream&) const;
+      void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
+  };
+}
+#endif
@@ -4,11 +4,13 @@
 #include "AntiMessage.h"
 #include "HasRange.h"
 #include "HasIdentifier.h"
+#include "ObjectPool.h"
 
 namespace pdesmas {
   class RangeQueryAntiMessage: public AntiMessage,
       public HasRange,
-      public HasIdentifier {
+      public HasIdentifier,
+      public Pooled<RangeQueryAntiMessage> {
     private:
       static AbstractMessage* CreateInstance();
 
@@ -20,6 +22,8 @@ namespace pdesmas {
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
   };
 }
 #endif
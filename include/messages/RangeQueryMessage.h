@@ -11,12 +11,14 @@
 #include "HasRange.h"
 #include "HasNumberOfTraverseHops.h"
 #include "HasSSVIDValueMap.h"
+#include "ObjectPool.h"
 
 namespace pdesmas {
   class RangeQueryMessage: public SharedStateMessage,
       public HasRange,
       public HasNumberOfTraverseHops,
-      public HasSSVIDValueMap {
+      public HasSSVIDValueMap,
+      public Pooled<RangeQueryMessage> {
     private:
       static AbstractMessage* CreateInstance();
 
@@ -28,6 +30,8 @@ namespace pdesmas {
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
   };
 }
 #endif
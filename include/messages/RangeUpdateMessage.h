@@ -4,14 +4,20 @@
 #include "LoadBalancingMessage.h"
 #include "HasTimestamp.h"
 #include "HasRange.h"
+#include "ObjectPool.h"
 
 namespace pdesmas {
   class RangeUpdateMessage: public LoadBalancingMessage,
       public HasTimestamp,
-      public HasRange {
+      public HasRange,
+      public Pooled<RangeUpdateMessage> {
     private:
       static AbstractMessage* CreateInstance();
 
+    protected:
+      unsigned long GetWireTimestamp() const;
+      void SetWireTimestamp(unsigned long);
+
     public:
       RangeUpdateMessage();
       virtual ~RangeUpdateMessage();
@@ -20,6 +26,8 @@ namespace pdesmas {
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
   };
 }
 #endif
@@ -29,9 +29,11 @@
 #include "SimulationMessage.h"
 #include "HasRollbackTag.h"
 #include "HasOriginalAgent.h"
+#include "ObjectPool.h"
 
 namespace pdesmas {
-  class RollbackMessage: public SimulationMessage, public HasRollbackTag, public HasOriginalAgent {
+  class RollbackMessage: public SimulationMessage, public HasRollbackTag, public HasOriginalAgent,
+      public Pooled<RollbackMessage> {
     private:
       static AbstractMessage* CreateInstance();
 
@@ -43,6 +45,8 @@ namespace pdesmas {
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
   };
 }
 #endif
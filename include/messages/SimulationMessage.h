@@ -15,12 +15,19 @@ namespace pdesmas {
   class SimulationMessage: public AbstractMessage,
       public HasTimestamp,
       public HasMatternColour {
+    protected:
+      unsigned long GetWireTimestamp() const;
+      void SetWireTimestamp(unsigned long);
+      MatternColour GetWireColour() const;
+      void SetWireColour(MatternColour);
+
     public:
       SimulationMessage();
       virtual ~SimulationMessage();
 
       void SendToLp(Lp *) const;
       void ReceiveToLp(Lp *) const;
+      MessageLane GetLane() const;
   };
 }
 #endif
@@ -3,9 +3,10 @@
 
 #include "AntiMessage.h"
 #include "HasSSVID.h"
+#include "ObjectPool.h"
 
 namespace pdesmas {
-  class SingleReadAntiMessage: public AntiMessage, public HasSSVID {
+  class SingleReadAntiMessage: public AntiMessage, public HasSSVID, public Pooled<SingleReadAntiMessage> {
     private:
       static AbstractMessage* CreateInstance();
 
@@ -17,6 +18,8 @@ namespace pdesmas {
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
   };
 }
 #endif
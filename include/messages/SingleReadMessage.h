@@ -9,10 +9,12 @@
 
 #include "SharedStateMessage.h"
 #include "HasSSVID.h"
+#include "ObjectPool.h"
 
 namespace pdesmas {
   class SingleReadMessage: public SharedStateMessage,
-    public HasSSVID {
+    public HasSSVID,
+    public Pooled<SingleReadMessage> {
     private:
       static AbstractMessage* CreateInstance();
 
@@ -24,6 +26,8 @@ namespace pdesmas {
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
   };
 }
 #endif
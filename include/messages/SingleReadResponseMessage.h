@@ -4,10 +4,12 @@
 #include "ResponseMessage.h"
 #include "HasValue.h"
 #include "SingleReadMessage.h"
+#include "ObjectPool.h"
 
 namespace pdesmas {
   class SingleReadResponseMessage: public ResponseMessage,
-      public HasValue {
+      public HasValue,
+      public Pooled<SingleReadResponseMessage> {
     private:
       static AbstractMessage* CreateInstance();
 
@@ -19,6 +21,8 @@ namespace pdesmas {
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
   };
 }
 #endif
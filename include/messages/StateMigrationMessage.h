@@ -3,10 +3,12 @@
 
 #include "LoadBalancingMessage.h"
 #include "HasStateVariableMap.h"
+#include "ObjectPool.h"
 
 namespace pdesmas {
   class StateMigrationMessage: public LoadBalancingMessage,
-      public HasStateVariableMap {
+      public HasStateVariableMap,
+      public Pooled<StateMigrationMessage> {
     private:
       static AbstractMessage* CreateInstance();
 
@@ -18,6 +20,8 @@ namespace pdesmas {
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
   };
 }
 #endif
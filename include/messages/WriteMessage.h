@@ -11,11 +11,13 @@
 #include "SharedStateMessage.h"
 #include "HasSSVID.h"
 #include "HasValue.h"
+#include "ObjectPool.h"
 
 namespace pdesmas {
   class WriteMessage: public SharedStateMessage,
       public HasSSVID,
-      public HasValue {
+      public HasValue,
+      public Pooled<WriteMessage> {
     private:
       static AbstractMessage* CreateInstance();
 
@@ -27,6 +29,8 @@ namespace pdesmas {
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
   };
 }
 #endif
@@ -4,10 +4,12 @@
 #include "ResponseMessage.h"
 #include "HasWriteStatus.h"
 #include "WriteMessage.h"
+#include "ObjectPool.h"
 
 namespace pdesmas {
   class WriteResponseMessage: public ResponseMessage,
-      public HasWriteStatus {
+      public HasWriteStatus,
+      public Pooled<WriteResponseMessage> {
     private:
       static AbstractMessage* CreateInstance();
 
@@ -19,6 +21,8 @@ namespace pdesmas {
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void PackPayload(WireWriter&) const;
+      void UnpackPayload(WireReader&);
   };
 }
 #endif
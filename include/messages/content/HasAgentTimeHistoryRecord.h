@@ -27,6 +27,10 @@ namespace pdesmas {
 
       void Deserialise(istream &) override;
 
+      void Pack(WireWriter &) const override;
+
+      void Unpack(WireReader &) override;
+
       map<unsigned long, list<unsigned long> > GetAgentTimeHistoryRecord() const;
 
       void SetAgentTimeHistoryRecord(map<unsigned long, list<unsigned long> >);
@@ -0,0 +1,27 @@
+/*
+ * HasSSVIDList.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * The shared state variables a batched read asks for, in the order the
+ * agent listed them.
+ */
+
+#ifndef HASSSVIDLIST_H_
+#define HASSSVIDLIST_H_
+
+#include "SerialisableList.h"
+#include "SsvId.h"
+
+namespace pdesmas {
+  class HasSSVIDList {
+    protected:
+      SerialisableList<SsvId> fSsvIdList;
+    public:
+      const SerialisableList<SsvId>& GetSsvIdList() const;
+      void SetSsvIdList(const SerialisableList<SsvId>&);
+      void AddSsvId(const SsvId&);
+  };
+}
+
+#endif /* HASSSVIDLIST_H_ */
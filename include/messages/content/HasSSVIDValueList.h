@@ -0,0 +1,42 @@
+/*
+ * HasSSVIDValueList.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Values of several shared state variables, for a batched write or the
+ * response to a batched read. Unlike HasSSVIDValueMap the values can be of
+ * any type, so they are kept like HasValue keeps its value: immutable and
+ * shared by reference count, only the encoding copies them. The messages
+ * call the encoding helpers below from their own Serialise and Pack.
+ */
+
+#ifndef HASSSVIDVALUELIST_H_
+#define HASSSVIDVALUELIST_H_
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include "SsvId.h"
+#include "AbstractValue.h"
+
+namespace pdesmas {
+  typedef std::vector<std::pair<SsvId, std::shared_ptr<const AbstractValue> > > SsvIdValueList;
+
+  class HasSSVIDValueList {
+    protected:
+      SsvIdValueList fSsvIdValueList;
+
+      void SerialiseSsvIdValueList(ostream&) const;
+      void DeserialiseSsvIdValueList(istream&);
+      void PackSsvIdValueList(WireWriter&) const;
+      void UnpackSsvIdValueList(WireReader&);
+    public:
+      const SsvIdValueList& GetSsvIdValueList() const;
+      // Takes ownership of the value
+      void AddSsvIdValue(const SsvId&, AbstractValue*);
+      void AddSsvIdValue(const SsvId&, const std::shared_ptr<const AbstractValue>&);
+      void ClearSsvIdValueList();
+  };
+}
+
+#endif /* HASSSVIDVALUELIST_H_ */
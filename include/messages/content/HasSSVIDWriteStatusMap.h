@@ -0,0 +1,26 @@
+/*
+ * HasSSVIDWriteStatusMap.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Write status of every shared state variable of a batched write.
+ */
+
+#ifndef HASSSVIDWRITESTATUSMAP_H_
+#define HASSSVIDWRITESTATUSMAP_H_
+
+#include "SerialisableMap.h"
+#include "SsvId.h"
+#include "WriteStatus.h"
+
+namespace pdesmas {
+  class HasSSVIDWriteStatusMap {
+    protected:
+      SerialisableMap<SsvId, WriteStatus> fSsvIdWriteStatusMap;
+    public:
+      const SerialisableMap<SsvId, WriteStatus>& GetSsvIdWriteStatusMap() const;
+      void SetSsvIdWriteStatus(const SsvId&, WriteStatus);
+  };
+}
+
+#endif /* HASSSVIDWRITESTATUSMAP_H_ */
@@ -8,15 +8,25 @@
 #ifndef HASVALUE_H_
 #define HASVALUE_H_
 
+#include <memory>
 #include "AbstractValue.h"
 
 namespace pdesmas {
+  /*
+   * Values are immutable once set and shared by reference count, between
+   * copies of a message and with the write period a read response came from.
+   * Only the wire encoding copies the value.
+   */
   class HasValue {
     protected:
-      AbstractValue* fValue;
+      std::shared_ptr<const AbstractValue> fValue;
     public:
       const AbstractValue* GetValue() const;
+      const std::shared_ptr<const AbstractValue>& GetSharedValue() const;
+      // Takes ownership of the value
       void SetValue(AbstractValue*);
+      void SetValue(const std::shared_ptr<const AbstractValue>&);
+      // Drops this message's reference, the value is freed with its last reference
       void ClearValue();
   };
 }
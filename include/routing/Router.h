@@ -41,6 +41,8 @@
 #include "SingleReadResponseMessage.h"
 #include "WriteAntiMessage.h"
 #include "WriteResponseMessage.h"
+#include "MultiReadResponseMessage.h"
+#include "MultiWriteResponseMessage.h"
 #include "GvtControlMessage.h"
 #include "GvtValueMessage.h"
 
@@ -68,9 +70,13 @@ namespace pdesmas {
       bool Route(WriteAntiMessage*);
       bool Route(WriteMessage*);
       bool Route(WriteResponseMessage*);
+      bool Route(MultiReadResponseMessage*);
+      bool Route(MultiWriteResponseMessage*);
 
       unsigned int GetLpRankByDirection(Direction) const;
       Direction GetDirectionByLpRank(unsigned int) const;
+      // Direction a message for the SSV goes in, batched messages are split by it
+      Direction GetDirectionBySsvId(const SsvId&) const;
       void SetSsvIdDirection(SsvId, Direction);
 
   };
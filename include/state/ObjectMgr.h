@@ -30,5 +30,9 @@ namespace pdesmas {
 
   extern string GetValueString(string msgString);
 
+  // Values held through an AbstractValue pointer, the type leads the packed value
+  extern void PackValue(WireWriter& pWriter, const AbstractValue* pValue);
+  extern AbstractValue* UnpackValue(WireReader& pReader);
+
 }
 #endif // OBJECTMGR_H
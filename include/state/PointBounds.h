@@ -0,0 +1,52 @@
+/*
+ * PointBounds.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Bounding range of the point values of the shared state variables over
+ * time. The bounds only change where a write period holding a point starts,
+ * so they are kept for each of those times, as sorted coordinates of the
+ * points the variables have from that time on. A change to one variable
+ * over a time interval updates the times in the interval, and looking up
+ * the range at a time finds the last time at or before it.
+ */
+
+#ifndef POINTBOUNDS_H_
+#define POINTBOUNDS_H_
+
+#include <map>
+#include <set>
+#include "Point.h"
+#include "Range.h"
+
+namespace pdesmas {
+  class PointBounds {
+    private:
+      struct Bounds {
+        std::multiset<int> fX;
+        std::multiset<int> fY;
+        // Points at (INT_MAX, INT_MAX), which Point::Min and Point::Max leave out of the range
+        unsigned long fUnboundedCount;
+
+        Bounds() :
+            fUnboundedCount(0) {
+        }
+      };
+
+      std::map<unsigned long, Bounds> fBoundsByTime;
+
+      static bool IsUnbounded(const Point&);
+      static void AddPoint(Bounds&, const Point&);
+      static void RemovePoint(Bounds&, const Point&);
+
+    public:
+      // One variable changes from the old to the new point over [start, end), either may be NULL
+      void Replace(const Point*, const Point*, unsigned long, unsigned long);
+      // Bounds before the time are no longer looked up
+      void RemoveBefore(unsigned long);
+      // New range for the caller to delete, NULL if no variable has a point at the time
+      Range* GetRange(unsigned long) const;
+  };
+}
+
+#endif /* POINTBOUNDS_H_ */
@@ -0,0 +1,50 @@
+/*
+ * PointGrid.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Uniform grid over the point values of the shared state variables, for
+ * range reads. Every write period holding a point is counted in the cell of
+ * its point, so a variable is found in the cell of the value it has at any
+ * time still kept. A range read only visits the cells overlapping the range,
+ * and checks the value its candidates have at the read time.
+ */
+
+#ifndef POINTGRID_H_
+#define POINTGRID_H_
+
+#include <map>
+#include <vector>
+#include "IdHashMap.h"
+#include "Point.h"
+#include "Range.h"
+
+// Width and height of a grid cell
+#ifndef POINT_GRID_CELL_SIZE
+#define POINT_GRID_CELL_SIZE 8
+#endif
+
+namespace pdesmas {
+  class PointGrid {
+    private:
+      struct Cell {
+        int fX;
+        int fY;
+        // Write periods in the cell by SSV id
+        std::map<unsigned long, unsigned int> fVersionCounts;
+      };
+
+      IdHashMap<Cell> fCells;
+
+      static int GetCellCoordinate(int);
+      static unsigned long GetCellKey(int, int);
+
+    public:
+      void Add(unsigned long, const Point&);
+      void Remove(unsigned long, const Point&);
+      // Ids of the variables with a write period in a cell overlapping the range, each id once
+      void FindCandidates(const Range&, std::vector<unsigned long>&) const;
+  };
+}
+
+#endif /* POINTGRID_H_ */
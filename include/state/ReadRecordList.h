@@ -0,0 +1,69 @@
+/*
+ * ReadRecordList.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Reads of one write period, kept as a flat vector with one record per
+ * agent, sorted by the time of its first read. A read by an agent that
+ * already has a record only widens the times the record spans, so repeated
+ * reads take no space. A record covers all reads of its agent from its first
+ * to its last time; rolling the agent back to the first time undoes every
+ * one of them. Reads on one side of a time are a prefix or suffix of the
+ * vector, and are erased as a range.
+ *
+ * Records are kept conservatively. Where a change splits the reads of an
+ * agent at a time, the part after it starts at that time, and an agent is
+ * rolled back to that time rather than to its first read after it.
+ */
+
+#ifndef READRECORDLIST_H_
+#define READRECORDLIST_H_
+
+#include <vector>
+#include "Serialisable.h"
+#include "LpId.h"
+#include "RollbackList.h"
+
+namespace pdesmas {
+  class ReadRecordList: public Serialisable {
+    private:
+      struct ReadRecord {
+        LpId fAgent;
+        unsigned long fFirstTime;
+        unsigned long fLastTime;
+      };
+
+      std::vector<ReadRecord> fReadRecords;
+
+      static bool HasFirstTimeBefore(const ReadRecord&, unsigned long);
+      static bool IsBeforeFirstTime(unsigned long, const ReadRecord&);
+      std::vector<ReadRecord>::iterator FindAgent(const LpId&);
+      // First record with its first read at or after the time
+      std::vector<ReadRecord>::iterator FindFirstAtOrAfter(unsigned long);
+      // Merge the reads of the agent over [first, last] into its record
+      void Add(const LpId&, unsigned long, unsigned long);
+
+    public:
+      void Add(const LpId&, unsigned long);
+      // Forget the reads before the time, they are no longer rolled back
+      void RemoveBefore(unsigned long);
+      // Roll back the agents reading at or after the time
+      void RemoveAfterInclusive(unsigned long, RollbackList&);
+      // The agent was rolled back to the time, its reads from then on are gone
+      void RemoveByAgent(const LpId&, unsigned long);
+      // Roll back every agent to the time
+      void RemoveAll(unsigned long, RollbackList&);
+      // Hand the reads at or after the time over to another list, returns the number of agents they were of
+      unsigned long MoveAfterInclusive(unsigned long, ReadRecordList&);
+      // Hand all reads over to another list, returns the number of agents they were of
+      unsigned long MoveAll(ReadRecordList&);
+      void Swap(ReadRecordList&);
+
+      void Serialise(ostream&) const;
+      void Deserialise(istream&);
+      void Pack(WireWriter&) const;
+      void Unpack(WireReader&);
+  };
+}
+
+#endif /* READRECORDLIST_H_ */
@@ -11,22 +11,56 @@
 #include "Log.h"
 #include "RangeRoutingTable.h"
 #include "AccessCostCalculator.h"
+#include "IdHashMap.h"
+#include "PointGrid.h"
+#include "PointBounds.h"
+#include "Mutex.h"
 
 using namespace std;
 namespace pdesmas {
   class SharedState {
     private:
-      map<SsvId, StateVariable> fStateVariableMap;
+      // State variables by raw SSV id
+      IdHashMap<StateVariable> fStateVariableMap;
       RangeRoutingTable* fRangeRoutingTable;
       AccessCostCalculator* fAccessCostCalculator;
+      // Value sizes and write periods of all state variables, a variable is taken out of the totals
+      // before it changes and added back after
+      unsigned long fValueSize;
+      unsigned long fVersionCount;
+      // Agents a write or write rollback did not roll back because the value they read stayed the same
+      unsigned long fKeptReadCount;
+      // Held around the changes to what the shards of a CLP share, NULL if the state is not sharded
+      Mutex* fShardMutex;
 
-      bool ContainsVariable(const SsvId&);
+      void AddToTotals(const StateVariable&);
+      void RemoveFromTotals(const StateVariable&);
+#ifdef RANGE_QUERIES
+      // Cells of the point values of all write periods, and their bounding range over time, kept up to date on
+      // every change to a write period list
+      PointGrid fPointGrid;
+      PointBounds fOwnPointBounds;
+      // The own bounds, or the bounds of all shards of a CLP
+      PointBounds* fPointBounds;
+
+      void AddPoints(const StateVariable&);
+      void RemovePoints(const StateVariable&);
+      void RemoveFromPointGridBefore(const StateVariable&, unsigned long);
+      // Point of the write period a write rollback at the time erases, NULL if it holds no point
+      Point* GetPointStartingAt(const StateVariable&, unsigned long) const;
+#endif
     public:
       SharedState();
       ~SharedState();
 
       void SetRangeRoutingTable(RangeRoutingTable*);
       void SetAccessCostCalculator(AccessCostCalculator*);
+      /*
+       * Make this state a shard of a CLP. The shards keep the bounds of their points together, and change those,
+       * the range routing table and the access counts only while holding the mutex. Adding, inserting, deleting
+       * and removing write periods are left to the CLP while its shards are idle.
+       */
+      void ShareWithShards(PointBounds*, Mutex*);
       void UpdateAccessCount(const SsvId&, Direction, unsigned long);
 
       void Add(const SsvId&, const AbstractValue*, unsigned long, const LpId&);
@@ -34,8 +68,10 @@ namespace pdesmas {
       void Delete(const SsvId&);
       StateVariable GetCopy(const SsvId&);
 
-      AbstractValue* Read(const SsvId&, const LpId&, unsigned long);
-      void WriteWithRollback(const SsvId&, const LpId&, const AbstractValue*, unsigned long, WriteStatus&, RollbackList&);
+      // The value is shared with the write period it was read from
+      std::shared_ptr<const AbstractValue> Read(const SsvId&, const LpId&, unsigned long);
+      void WriteWithRollback(const SsvId&, const LpId&, const std::shared_ptr<const AbstractValue>&, unsigned long,
+                             WriteStatus&, RollbackList&);
       SerialisableMap<SsvId, Value<Point> > RangeRead(const Range&, Direction, unsigned long, unsigned long);
       Range* RecalculateRange(unsigned long) const;
 
@@ -44,6 +80,10 @@ namespace pdesmas {
 
       void RemoveWritePeriods(unsigned long);
       void RemoveWritePeriodList(const SsvId&, RollbackList&);
+
+      unsigned long GetValueSize() const;
+      unsigned long GetVersionCount() const;
+      unsigned long GetKeptReadCount() const;
   };
 }
 #endif
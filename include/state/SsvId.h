@@ -36,6 +36,10 @@ namespace pdesmas {
     void Serialise(ostream &) const override;
 
     void Deserialise(istream &) override;
+
+    void Pack(WireWriter &) const override;
+
+    void Unpack(WireReader &) override;
   };
 }
 
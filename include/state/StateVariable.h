@@ -4,7 +4,7 @@
 #include "WritePeriod.h"
 #include "RollbackList.h"
 #include "WriteStatus.h"
-#include "SerialisableList.h"
+#include "SerialisableDeque.h"
 #include "Log.h"
 
 using namespace std;
@@ -13,7 +13,12 @@ namespace pdesmas {
   class StateVariable: public Serialisable {
     private:
       SsvId fStateVariableID;
-      SerialisableList<WritePeriod> fWritePeriodList;
+      // Write periods sorted by start time
+      SerialisableDeque<WritePeriod> fWritePeriodList;
+      // Sum of the value sizes of the write periods, kept up to date on every change to the list
+      unsigned long fValueSize;
+
+      void RecalculateValueSize();
 
     public:
       StateVariable();
@@ -24,15 +29,30 @@ namespace pdesmas {
       const SsvId& GetVariableId() const;
       void AddWritePeriod(const AbstractValue*, unsigned long, const LpId&);
       void RemoveWritePeriods(unsigned long);
-      const SerialisableList<WritePeriod>& GetWritePeriodList() const;
+      const SerialisableDeque<WritePeriod>& GetWritePeriodList() const;
+      unsigned long GetValueSize() const;
+      unsigned long GetVersionCount() const;
 
-      AbstractValue* Read(const LpId&, unsigned long);
-      pair<unsigned long, AbstractValue*> ReadWithoutRecord(unsigned long) const;
-      void WriteWithRollback(const LpId&, const AbstractValue*, unsigned long, WriteStatus&, RollbackList&);
+      std::shared_ptr<const AbstractValue> Read(const LpId&, unsigned long);
+      // The value stays owned by the write period, valid until the write period list changes
+      pair<unsigned long, const StoredValue*> ReadWithoutRecord(unsigned long) const;
+      // First write period starting at the time, the one PerformWriteRollback erases, NULL if there is none
+      const WritePeriod* FindWritePeriodStartingAt(unsigned long) const;
+      // Start time of the first write period starting after the time, ULONG_MAX if there is none
+      unsigned long GetNextStartTime(unsigned long) const;
+      /*
+       * The write and the write rollback return how many reads they left in place instead of rolling them back.
+       * With LAZY_CANCELLATION defined a read is only rolled back if the value visible at its time changes, the
+       * reads that would see the same value move over to the write period that now holds it.
+       */
+      unsigned long WriteWithRollback(const LpId&, const std::shared_ptr<const AbstractValue>&, unsigned long,
+                                      WriteStatus&, RollbackList&);
       void PerformReadRollback(const LpId&, unsigned long);
-      void PerformWriteRollback(const LpId&, unsigned long, RollbackList&);
+      unsigned long PerformWriteRollback(const LpId&, unsigned long, RollbackList&);
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void Pack(WireWriter&) const;
+      void Unpack(WireReader&);
   };
 }
 #endif
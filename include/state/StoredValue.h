@@ -0,0 +1,65 @@
+/*
+ * StoredValue.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Value held by a write period. Integers, longs, doubles and points are
+ * kept inline in a tagged union, so storing, copying and reading them does
+ * not allocate. Strings, and any other value type, are kept as an immutable
+ * AbstractValue shared by reference count with the messages carrying it, so
+ * a read hands out the same value instead of a copy.
+ */
+
+#ifndef STOREDVALUE_H_
+#define STOREDVALUE_H_
+
+#include <memory>
+#include "AbstractValue.h"
+#include "Point.h"
+
+namespace pdesmas {
+  class StoredValue {
+    private:
+      bool fHasValue;
+      pdesmasType fType;
+      union {
+        int fInt;
+        long fLong;
+        double fDouble;
+        int fPoint[2];
+      } fData;
+      // Only set for values that are not kept inline
+      std::shared_ptr<const AbstractValue> fSharedValue;
+
+      bool IsInline() const;
+      // Copy an inline value out of the AbstractValue, returns false if its type is not kept inline
+      bool SetInline(const AbstractValue*);
+
+    public:
+      StoredValue();
+
+      bool IsEmpty() const;
+      pdesmasType GetType() const;
+      // Copy the value in, NULL leaves the stored value empty
+      void Set(const AbstractValue*);
+      // Share the value instead of copying it, unless it is kept inline
+      void Set(const std::shared_ptr<const AbstractValue>&);
+      // New heap copy of the value for the caller to delete, NULL if empty
+      AbstractValue* CreateValue() const;
+      // The value for a message, shared unless it is kept inline, NULL if empty
+      std::shared_ptr<const AbstractValue> GetSharedValue() const;
+      // Only for VALUEPOINT values
+      Point GetPoint() const;
+      // Length of the value string
+      unsigned long GetSize() const;
+      // Same type and value, two empty values are equal
+      bool IsEqual(const StoredValue&) const;
+
+      // Same formats as the AbstractValue the value came from
+      void Serialise(ostream&) const;
+      void Pack(WireWriter&) const;
+      void Unpack(WireReader&);
+  };
+}
+
+#endif /* STOREDVALUE_H_ */
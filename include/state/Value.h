@@ -43,7 +43,7 @@ namespace pdesmas {
 
     pdesmasType GetType() const;
 
-    valueType GetValue() const;
+    const valueType &GetValue() const;
 
     string GetValueString() const;
 
@@ -53,6 +53,10 @@ namespace pdesmas {
 
     void Deserialise(istream &);
 
+    void Pack(WireWriter &) const;
+
+    void Unpack(WireReader &);
+
     virtual void RegisterWithAbstract();
 
     virtual AbstractValue *RecreateObject(pdesmasType);
@@ -105,7 +109,7 @@ namespace pdesmas {
   }
 
   template<typename valueType>
-  valueType Value<valueType>::GetValue() const {
+  const valueType &Value<valueType>::GetValue() const {
     return fValueData;
   }
 
@@ -135,6 +139,16 @@ namespace pdesmas {
     IgnoreTo(pIstream, DELIM_RIGHT);
   }
 
+  template<typename valueType>
+  void Value<valueType>::Pack(WireWriter &pWriter) const {
+    pWriter << fType << fValueData;
+  }
+
+  template<typename valueType>
+  void Value<valueType>::Unpack(WireReader &pReader) {
+    pReader >> fType >> fValueData;
+  }
+
   template<typename valueType>
   void Value<valueType>::RegisterWithAbstract() {
     valueClassMap->RegisterObject(fType, (AbstractValue *(*)()) createValue);
@@ -4,9 +4,10 @@
 using namespace std;
 #include "Serialisable.h"
 #include "ObjectMgr.h"
-#include "SerialisableMultiMap.h"
+#include "ReadRecordList.h"
 #include "Log.h"
 #include "RollbackList.h"
+#include "StoredValue.h"
 
 namespace pdesmas {
 
@@ -14,20 +15,30 @@ namespace pdesmas {
     private:
       unsigned long fStartTime;
       unsigned long fEndTime;
-      AbstractValue* fValue;
+      StoredValue fValue;
       LpId fAgent;
-      SerialisableMultiMap<LpId, unsigned long> fAgentReadMap;
+      ReadRecordList fReadRecordList;
     public:
       WritePeriod();
       WritePeriod(const AbstractValue* pValue, unsigned long pStartTime, const LpId& pAgent);
+      // Shares the value with the caller instead of copying it
+      WritePeriod(const std::shared_ptr<const AbstractValue>& pValue, unsigned long pStartTime, const LpId& pAgent);
       WritePeriod(const WritePeriod&);
-      ~WritePeriod();
+      // Moving takes over the value instead of cloning it, for shifting periods around in their StateVariable
+      WritePeriod(WritePeriod&&);
 
-      AbstractValue* Read(const LpId&, unsigned long);
+      WritePeriod& operator=(const WritePeriod&);
+      WritePeriod& operator=(WritePeriod&&);
+
+      std::shared_ptr<const AbstractValue> Read(const LpId&, unsigned long);
       void RemoveReadsBefore(unsigned long);
       void RemoveReadsAfterInclusive(unsigned long, RollbackList&);
       void RemoveReadsByAgent(const LpId&, unsigned long);
       void RemoveAllReads(unsigned long, RollbackList&);
+      // Hand the reads at or after the time over to another write period, returns the number of agents moved
+      unsigned long MoveReadsAfterInclusive(unsigned long, WritePeriod&);
+      // Hand all reads over to another write period, returns the number of agents moved
+      unsigned long MoveAllReads(WritePeriod&);
 
       void SetStartTime(unsigned long);
       unsigned long GetStartTime() const;
@@ -37,9 +48,15 @@ namespace pdesmas {
       unsigned long GetEndTime() const;
       void SetValue(const AbstractValue*);
       AbstractValue* GetValueCopy() const ;
+      // The stored value itself, reading it does not allocate
+      const StoredValue& GetValue() const;
+      // Length of the value string, the measure the memory accounting uses
+      unsigned long GetValueSize() const;
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void Pack(WireWriter&) const;
+      void Unpack(WireReader&);
   };
 }
 #endif
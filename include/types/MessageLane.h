@@ -0,0 +1,29 @@
+/*
+ * MessageLane.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Priority lanes for messages between LPs, highest priority first, in the
+ * order Clp::Send drains its send queues. Every lane has its own MPI tags,
+ * receive slots and receive queue at the Lp, so control and load balancing
+ * traffic does not wait behind simulation messages.
+ */
+
+#ifndef MESSAGELANE_H_
+#define MESSAGELANE_H_
+
+namespace pdesmas {
+  enum MessageLane {
+    LOAD_BALANCING_LANE = 0, CONTROL_LANE, SIMULATION_LANE, LANE_SIZE
+  };
+
+  inline const char* GetLaneName(MessageLane pLane) {
+    switch (pLane) {
+      case LOAD_BALANCING_LANE : return "load balancing";
+      case CONTROL_LANE : return "control";
+      case SIMULATION_LANE : return "simulation";
+      default : return "unknown";
+    }
+  }
+}
+#endif /* MESSAGELANE_H_ */
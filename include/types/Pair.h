@@ -41,6 +41,8 @@ namespace pdesmas {
       Pair<ValueType>& operator=(Pair<ValueType> const&);
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void Pack(WireWriter&) const;
+      void Unpack(WireReader&);
   };
 
   template<typename ValueType>
@@ -116,5 +118,15 @@ namespace pdesmas {
     pIstream >> fY;
     pIstream.ignore(numeric_limits<streamsize>::max(), DELIM_RIGHT);
   }
+
+  template<typename ValueType>
+  void Pair<ValueType>::Pack(WireWriter& pWriter) const {
+    pWriter << fX << fY;
+  }
+
+  template<typename ValueType>
+  void Pair<ValueType>::Unpack(WireReader& pReader) {
+    pReader >> fX >> fY;
+  }
 }
 #endif
@@ -0,0 +1,82 @@
+/*
+ * SerialisableDeque.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Deque counterpart of SerialisableList, with the same text and wire
+ * format, so either container can be read back from the other.
+ */
+
+#ifndef SERIALISABLEDEQUE_H_
+#define SERIALISABLEDEQUE_H_
+
+#include <deque>
+#include "Serialisable.h"
+
+namespace pdesmas {
+  template<typename valueType>
+  class SerialisableDeque: public deque<valueType> , public Serialisable {
+    public:
+      SerialisableDeque();
+      virtual ~SerialisableDeque();
+
+      void Serialise(ostream&) const;
+      void Deserialise(istream&);
+      void Pack(WireWriter&) const;
+      void Unpack(WireReader&);
+  };
+
+  template<typename valueType>
+  SerialisableDeque<valueType>::SerialisableDeque() = default;
+
+  template<typename valueType>
+  SerialisableDeque<valueType>::~SerialisableDeque() = default;
+
+  template<typename valueType>
+  void SerialisableDeque<valueType>::Serialise(ostream& pOstream) const {
+    const unsigned int size = this->size();
+    pOstream << size;
+    typename deque<valueType>::const_iterator iter;
+    for (iter = this->begin(); iter != this->end(); ++iter) {
+      pOstream << DELIM_LIST_LEFT << *iter << DELIM_LIST_RIGHT;
+    }
+  }
+
+  template<typename valueType>
+  void SerialisableDeque<valueType>::Deserialise(istream& pIstream) {
+    this->clear();
+    unsigned int size;
+    pIstream >> size;
+    for (unsigned int counter = 0; counter < size; ++counter) {
+      pIstream.ignore(numeric_limits<streamsize>::max(), DELIM_LIST_LEFT);
+      valueType theValue;
+      pIstream >> theValue;
+      this->push_back(theValue);
+      pIstream.ignore(numeric_limits<streamsize>::max(), DELIM_LIST_RIGHT);
+    }
+  }
+
+  template<typename valueType>
+  void SerialisableDeque<valueType>::Pack(WireWriter& pWriter) const {
+    const unsigned int size = this->size();
+    pWriter << size;
+    typename deque<valueType>::const_iterator iter;
+    for (iter = this->begin(); iter != this->end(); ++iter) {
+      pWriter << *iter;
+    }
+  }
+
+  template<typename valueType>
+  void SerialisableDeque<valueType>::Unpack(WireReader& pReader) {
+    this->clear();
+    unsigned int size;
+    pReader >> size;
+    for (unsigned int counter = 0; counter < size && pReader.IsGood(); ++counter) {
+      valueType theValue;
+      pReader >> theValue;
+      this->push_back(theValue);
+    }
+  }
+}
+
+#endif /* SERIALISABLEDEQUE_H_ */
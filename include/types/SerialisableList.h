@@ -10,6 +10,9 @@
 
 #include <list>
 #include "Serialisable.h"
+using std::list;
+using std::numeric_limits;
+using std::streamsize;
 
 namespace pdesmas {
   template<typename valueType>
@@ -20,6 +23,8 @@ namespace pdesmas {
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void Pack(WireWriter&) const;
+      void Unpack(WireReader&);
   };
 
   template<typename valueType>
@@ -51,6 +56,28 @@ namespace pdesmas {
       pIstream.ignore(numeric_limits<streamsize>::max(), DELIM_LIST_RIGHT);
     }
   }
+
+  template<typename valueType>
+  void SerialisableList<valueType>::Pack(WireWriter& pWriter) const {
+    const unsigned int size = this->size();
+    pWriter << size;
+    typename list<valueType>::const_iterator iter;
+    for (iter = this->begin(); iter != this->end(); ++iter) {
+      pWriter << *iter;
+    }
+  }
+
+  template<typename valueType>
+  void SerialisableList<valueType>::Unpack(WireReader& pReader) {
+    this->clear();
+    unsigned int size;
+    pReader >> size;
+    for (unsigned int counter = 0; counter < size && pReader.IsGood(); ++counter) {
+      valueType theValue;
+      pReader >> theValue;
+      this->push_back(theValue);
+    }
+  }
 }
 
 #endif /* SERIALISABLELIST_H_ */
@@ -24,6 +24,8 @@ namespace pdesmas {
 
       void Serialise(ostream&) const;
       void Deserialise(istream&);
+      void Pack(WireWriter&) const;
+      void Unpack(WireReader&);
   };
 
   template<typename keyType, typename valueType>
@@ -58,6 +60,30 @@ namespace pdesmas {
       pIstream.ignore(numeric_limits<streamsize>::max(), DELIM_LIST_RIGHT);
     }
   }
+
+  template<typename keyType, typename valueType>
+  void SerialisableMap<keyType, valueType>::Pack(WireWriter& pWriter) const {
+    const unsigned int size = this->size();
+    pWriter << size;
+    typename map<keyType, valueType>::const_iterator iter;
+    for (iter = this->begin(); iter != this->end(); ++iter) {
+      pWriter << iter->first << iter->second;
+    }
+  }
+
+  template<typename keyType, typename valueType>
+  void SerialisableMap<keyType, valueType>::Unpack(WireReader& pReader) {
+    this->clear();
+    unsigned int size;
+    pReader >> size;
+    for (unsigned int counter = 0; counter < size && pReader.IsGood(); ++counter) {
+      keyType key;
+      pReader >> key;
+      valueType value;
+      pReader >> value;
+      this->insert(make_pair(key, value));
+    }
+  }
 }
 
 #endif /* SERIALISABLEMAP_H_ */
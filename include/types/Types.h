@@ -9,6 +9,7 @@
 #define TYPES_H_
 
 #include "Helper.h"
+#include "WireBuffer.h"
 
 using namespace std;
 
@@ -33,7 +34,11 @@ namespace pdesmas {
     STATEMIGRATIONMESSAGE = 16,
     WRITEANTIMESSAGE = 17,
     WRITEMESSAGE = 18,
-    WRITERESPONSEMESSAGE = 19
+    WRITERESPONSEMESSAGE = 19,
+    MULTIREADMESSAGE = 20,
+    MULTIREADRESPONSEMESSAGE = 21,
+    MULTIWRITEMESSAGE = 22,
+    MULTIWRITERESPONSEMESSAGE = 23
   };
 
   inline istream& operator>>(istream& pIstream, pdesmasType& pType) {
@@ -60,11 +65,17 @@ namespace pdesmas {
       case WRITEANTIMESSAGE : pType = WRITEANTIMESSAGE; break;
       case WRITEMESSAGE : pType = WRITEMESSAGE; break;
       case WRITERESPONSEMESSAGE : pType = WRITERESPONSEMESSAGE; break;
+      case MULTIREADMESSAGE : pType = MULTIREADMESSAGE; break;
+      case MULTIREADRESPONSEMESSAGE : pType = MULTIREADRESPONSEMESSAGE; break;
+      case MULTIWRITEMESSAGE : pType = MULTIWRITEMESSAGE; break;
+      case MULTIWRITERESPONSEMESSAGE : pType = MULTIWRITERESPONSEMESSAGE; break;
     }
     return pIstream;
   }
 
   extern pdesmasType GetTypeID(string pString);
+  // Type of a message packed in the binary wire format
+  extern pdesmasType GetTypeID(const WireReader& pReader);
 
   bool IsSimulationMessage(pdesmasType);
   bool IsSharedStateMessage(pdesmasType);
@@ -0,0 +1,97 @@
+/*
+ * Backoff.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Idle strategy for polling loops. After an empty poll the loop first spins
+ * with sched_yield, then sleeps for intervals doubling up to a maximum. Any
+ * work resets it to spinning. The time between calls is booked as work,
+ * spinning or sleeping so the loop can report how busy it really was.
+ */
+
+#ifndef BACKOFF_H_
+#define BACKOFF_H_
+
+#include <sched.h>
+#include <unistd.h>
+#include "Helper.h"
+
+// Empty polls answered with sched_yield before the first sleep
+#ifndef BACKOFF_SPIN_LIMIT
+#define BACKOFF_SPIN_LIMIT 256
+#endif
+// First and longest sleep in microseconds
+#ifndef BACKOFF_MIN_SLEEP
+#define BACKOFF_MIN_SLEEP 10
+#endif
+#ifndef BACKOFF_MAX_SLEEP
+#define BACKOFF_MAX_SLEEP 1000
+#endif
+
+namespace pdesmas {
+  class Backoff {
+    private:
+      unsigned int fSpinCount;
+      unsigned long fSleepInterval;
+      unsigned long fLastTime;
+      unsigned long fWorkTime;
+      unsigned long fSpinTime;
+      unsigned long fSleepTime;
+      unsigned long fSleepCount;
+    public:
+      Backoff() :
+          fSpinCount(0), fSleepInterval(BACKOFF_MIN_SLEEP), fLastTime(Helper::GetTimeInUS()), fWorkTime(0),
+          fSpinTime(0), fSleepTime(0), fSleepCount(0) {
+      }
+
+      // Called after a poll that found nothing to do
+      void Idle() {
+        unsigned long now = Helper::GetTimeInUS();
+        fSpinTime += now - fLastTime;
+        if (fSpinCount < BACKOFF_SPIN_LIMIT) {
+          ++fSpinCount;
+          sched_yield();
+          fLastTime = now;
+          return;
+        }
+        usleep(fSleepInterval);
+        ++fSleepCount;
+        fSleepInterval = (fSleepInterval * 2 < BACKOFF_MAX_SLEEP) ? fSleepInterval * 2 : BACKOFF_MAX_SLEEP;
+        fLastTime = Helper::GetTimeInUS();
+        fSleepTime += fLastTime - now;
+      }
+
+      // Called after work has been done, the next idle period starts spinning again
+      void Work() {
+        unsigned long now = Helper::GetTimeInUS();
+        fWorkTime += now - fLastTime;
+        fLastTime = now;
+        fSpinCount = 0;
+        fSleepInterval = BACKOFF_MIN_SLEEP;
+      }
+
+      // Book the time since the last call as neither idle nor work, e.g. after blocking elsewhere
+      void Skip() {
+        fLastTime = Helper::GetTimeInUS();
+      }
+
+      // Accumulated times in microseconds
+      unsigned long GetWorkTime() const {
+        return fWorkTime;
+      }
+
+      unsigned long GetSpinTime() const {
+        return fSpinTime;
+      }
+
+      unsigned long GetSleepTime() const {
+        return fSleepTime;
+      }
+
+      unsigned long GetSleepCount() const {
+        return fSleepCount;
+      }
+  };
+}
+
+#endif /* BACKOFF_H_ */
@@ -10,6 +10,7 @@
 
 #include <sstream>
 #include <sys/time.h>
+#include <time.h>
 
 namespace Helper {
   template<typename inType>
@@ -36,5 +37,13 @@ namespace Helper {
         * (unsigned long int) 1000) + ((unsigned long int) timeValue.tv_usec
         / (unsigned long int) 1000);
   }
+
+  // Monotonic time in microseconds, for measuring short intervals
+  inline unsigned long GetTimeInUS() {
+    timespec timeValue;
+    clock_gettime(CLOCK_MONOTONIC, &timeValue);
+    return ((unsigned long int) timeValue.tv_sec * (unsigned long int) 1000000)
+        + ((unsigned long int) timeValue.tv_nsec / (unsigned long int) 1000);
+  }
 }
 #endif /* HELPER_H_ */
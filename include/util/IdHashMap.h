@@ -0,0 +1,212 @@
+/*
+ * IdHashMap.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Hash map from 64 bit identifiers to values, for tables looked up on every
+ * message. The buckets are an open addressing table with linear probing
+ * that holds the key and the slot of its value, so a lookup only touches the
+ * bucket array until it finds the key. Values live in slots that never move,
+ * pointers to them stay valid until the value is erased. Erased slots are
+ * reused by later inserts. Iteration walks the slots in order, skipping the
+ * free ones, and visits the values only.
+ */
+
+#ifndef IDHASHMAP_H_
+#define IDHASHMAP_H_
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <vector>
+
+namespace pdesmas {
+  template<class T>
+  class IdHashMap {
+    private:
+      struct Bucket {
+        unsigned long fKey;
+        // Index of the value slot, EMPTY_BUCKET if the bucket is free
+        size_t fSlot;
+      };
+
+      struct Slot {
+        bool fIsUsed;
+        T fValue;
+      };
+
+      static const size_t EMPTY_BUCKET = (size_t) -1;
+      static const size_t INITIAL_BUCKET_COUNT = 16;
+
+      std::vector<Bucket> fBuckets;
+      std::deque<Slot> fSlots;
+      std::vector<size_t> fFreeSlots;
+      size_t fSize;
+
+      // Identifiers are often handed out in sequence, mix the bits so they spread over the buckets
+      static size_t Hash(unsigned long pKey) {
+        unsigned long hash = pKey;
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdUL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53UL;
+        hash ^= hash >> 33;
+        return (size_t) hash;
+      }
+
+      size_t GetMask() const {
+        return fBuckets.size() - 1;
+      }
+
+      // Bucket holding the key, or the free bucket ending its probe sequence
+      size_t FindBucket(unsigned long pKey) const {
+        size_t bucket = Hash(pKey) & GetMask();
+        while (fBuckets[bucket].fSlot != EMPTY_BUCKET && fBuckets[bucket].fKey != pKey) {
+          bucket = (bucket + 1) & GetMask();
+        }
+        return bucket;
+      }
+
+      void Rehash(size_t pBucketCount) {
+        std::vector<Bucket> oldBuckets;
+        oldBuckets.swap(fBuckets);
+        Bucket emptyBucket = {0, EMPTY_BUCKET};
+        fBuckets.assign(pBucketCount, emptyBucket);
+        for (const Bucket& bucket : oldBuckets) {
+          if (bucket.fSlot != EMPTY_BUCKET) fBuckets[FindBucket(bucket.fKey)] = bucket;
+        }
+      }
+
+    public:
+      template<class SlotIterator, class Value>
+      class BasicIterator: public std::iterator<std::forward_iterator_tag, Value> {
+        private:
+          SlotIterator fSlot;
+          SlotIterator fEnd;
+
+          void SkipFreeSlots() {
+            while (fSlot != fEnd && !fSlot->fIsUsed) ++fSlot;
+          }
+
+        public:
+          BasicIterator(SlotIterator pSlot, SlotIterator pEnd) :
+              fSlot(pSlot), fEnd(pEnd) {
+            SkipFreeSlots();
+          }
+
+          Value& operator*() const {
+            return fSlot->fValue;
+          }
+
+          Value* operator->() const {
+            return &fSlot->fValue;
+          }
+
+          BasicIterator& operator++() {
+            ++fSlot;
+            SkipFreeSlots();
+            return *this;
+          }
+
+          bool operator==(const BasicIterator& pOther) const {
+            return fSlot == pOther.fSlot;
+          }
+
+          bool operator!=(const BasicIterator& pOther) const {
+            return fSlot != pOther.fSlot;
+          }
+      };
+
+      typedef BasicIterator<typename std::deque<Slot>::iterator, T> iterator;
+      typedef BasicIterator<typename std::deque<Slot>::const_iterator, const T> const_iterator;
+
+      IdHashMap() :
+          fSize(0) {
+        Bucket emptyBucket = {0, EMPTY_BUCKET};
+        fBuckets.assign(INITIAL_BUCKET_COUNT, emptyBucket);
+      }
+
+      size_t Size() const {
+        return fSize;
+      }
+
+      // Returns NULL if the key is not in the map
+      T* Find(unsigned long pKey) {
+        const Bucket& bucket = fBuckets[FindBucket(pKey)];
+        return (bucket.fSlot == EMPTY_BUCKET) ? NULL : &fSlots[bucket.fSlot].fValue;
+      }
+
+      const T* Find(unsigned long pKey) const {
+        const Bucket& bucket = fBuckets[FindBucket(pKey)];
+        return (bucket.fSlot == EMPTY_BUCKET) ? NULL : &fSlots[bucket.fSlot].fValue;
+      }
+
+      // Insert a default value for a new key, returns the value and whether it was inserted
+      std::pair<T*, bool> Insert(unsigned long pKey) {
+        size_t bucket = FindBucket(pKey);
+        if (fBuckets[bucket].fSlot != EMPTY_BUCKET) return std::make_pair(&fSlots[fBuckets[bucket].fSlot].fValue, false);
+        // Keep the table at most half full so probe sequences stay short
+        if (2 * (fSize + 1) > fBuckets.size()) {
+          Rehash(2 * fBuckets.size());
+          bucket = FindBucket(pKey);
+        }
+        size_t slot;
+        if (fFreeSlots.empty()) {
+          slot = fSlots.size();
+          Slot newSlot = {true, T()};
+          fSlots.push_back(newSlot);
+        } else {
+          slot = fFreeSlots.back();
+          fFreeSlots.pop_back();
+          fSlots[slot].fIsUsed = true;
+        }
+        fBuckets[bucket].fKey = pKey;
+        fBuckets[bucket].fSlot = slot;
+        ++fSize;
+        return std::make_pair(&fSlots[slot].fValue, true);
+      }
+
+      // Returns false if the key is not in the map
+      bool Erase(unsigned long pKey) {
+        size_t bucket = FindBucket(pKey);
+        if (fBuckets[bucket].fSlot == EMPTY_BUCKET) return false;
+        // Release the value now and keep the slot for the next insert
+        Slot& slot = fSlots[fBuckets[bucket].fSlot];
+        slot.fIsUsed = false;
+        slot.fValue = T();
+        fFreeSlots.push_back(fBuckets[bucket].fSlot);
+        --fSize;
+        // Shift later buckets of the probe sequence back instead of leaving a tombstone
+        size_t next = (bucket + 1) & GetMask();
+        while (fBuckets[next].fSlot != EMPTY_BUCKET) {
+          size_t home = Hash(fBuckets[next].fKey) & GetMask();
+          // Move the bucket unless its home lies cyclically in (bucket, next]
+          if (((next - home) & GetMask()) >= ((next - bucket) & GetMask())) {
+            fBuckets[bucket] = fBuckets[next];
+            bucket = next;
+          }
+          next = (next + 1) & GetMask();
+        }
+        fBuckets[bucket].fSlot = EMPTY_BUCKET;
+        return true;
+      }
+
+      iterator begin() {
+        return iterator(fSlots.begin(), fSlots.end());
+      }
+
+      iterator end() {
+        return iterator(fSlots.end(), fSlots.end());
+      }
+
+      const_iterator begin() const {
+        return const_iterator(fSlots.begin(), fSlots.end());
+      }
+
+      const_iterator end() const {
+        return const_iterator(fSlots.end(), fSlots.end());
+      }
+  };
+}
+
+#endif /* IDHASHMAP_H_ */
@@ -0,0 +1,253 @@
+/*
+ * ObjectPool.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ * Free list pools of fixed size blocks, one pool per class. A class takes
+ * its instances from its pool by inheriting from Pooled<Class>, which
+ * replaces its operator new and delete when OBJECT_POOLS is defined. Every
+ * thread caches free blocks and exchanges them with the shared free list of
+ * the pool in batches, so objects created by one thread and deleted by
+ * another only take the pool lock once per batch. Blocks are kept for reuse
+ * and never given back to the heap.
+ */
+
+#ifndef OBJECTPOOL_H_
+#define OBJECTPOOL_H_
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#include <cxxabi.h>
+#include <spdlog/spdlog.h>
+#include "Mutex.h"
+
+// Free blocks a thread caches per pool, half of them move to or from the shared free list at once
+#ifndef OBJECT_POOL_CACHE_SIZE
+#define OBJECT_POOL_CACHE_SIZE 64
+#endif
+
+namespace pdesmas {
+  /*
+   * Counters shared by all pools, and the list of pools created so far
+   */
+  class ObjectPoolBase {
+    private:
+      std::string fName;
+      std::atomic<unsigned long> fAllocationCount;
+      std::atomic<unsigned long> fHitCount;
+      std::atomic<long> fLiveCount;
+      std::atomic<long> fPeakLiveCount;
+
+      static Mutex& GetRegistryMutex() {
+        static Mutex registryMutex;
+        return registryMutex;
+      }
+
+      static std::vector<ObjectPoolBase*>& GetRegistry() {
+        static std::vector<ObjectPoolBase*> registry;
+        return registry;
+      }
+
+    protected:
+      ObjectPoolBase(const char* pTypeName) :
+          fAllocationCount(0), fHitCount(0), fLiveCount(0), fPeakLiveCount(0) {
+        int status;
+        char* demangledName = abi::__cxa_demangle(pTypeName, nullptr, nullptr, &status);
+        fName = (status == 0) ? demangledName : pTypeName;
+        free(demangledName);
+        GetRegistryMutex().Lock();
+        GetRegistry().push_back(this);
+        GetRegistryMutex().Unlock();
+      }
+
+      void CountAllocation(bool pIsHit) {
+        fAllocationCount.fetch_add(1, std::memory_order_relaxed);
+        if (pIsHit) fHitCount.fetch_add(1, std::memory_order_relaxed);
+        long liveCount = fLiveCount.fetch_add(1, std::memory_order_relaxed) + 1;
+        long peakLiveCount = fPeakLiveCount.load(std::memory_order_relaxed);
+        while (liveCount > peakLiveCount
+            && !fPeakLiveCount.compare_exchange_weak(peakLiveCount, liveCount, std::memory_order_relaxed)) {
+        }
+      }
+
+      void CountRelease() {
+        fLiveCount.fetch_sub(1, std::memory_order_relaxed);
+      }
+
+    public:
+      virtual ~ObjectPoolBase() {
+      }
+
+      const std::string& GetName() const {
+        return fName;
+      }
+
+      unsigned long GetAllocationCount() const {
+        return fAllocationCount.load(std::memory_order_relaxed);
+      }
+
+      // Allocations served from a free block rather than the heap
+      unsigned long GetHitCount() const {
+        return fHitCount.load(std::memory_order_relaxed);
+      }
+
+      double GetHitRate() const {
+        unsigned long allocationCount = GetAllocationCount();
+        return (allocationCount == 0) ? 0 : (double) GetHitCount() / allocationCount;
+      }
+
+      long GetLiveCount() const {
+        return fLiveCount.load(std::memory_order_relaxed);
+      }
+
+      long GetPeakLiveCount() const {
+        return fPeakLiveCount.load(std::memory_order_relaxed);
+      }
+
+      // Log the counters of every pool used by this process
+      static void LogStatistics() {
+        GetRegistryMutex().Lock();
+        for (const ObjectPoolBase* pool : GetRegistry()) {
+          spdlog::info("ObjectPool::LogStatistics# {0}: {1} allocations, hit rate {2:.1f}%, peak live {3}, live {4}",
+                       pool->GetName(), pool->GetAllocationCount(), 100 * pool->GetHitRate(),
+                       pool->GetPeakLiveCount(), pool->GetLiveCount());
+        }
+        GetRegistryMutex().Unlock();
+      }
+  };
+
+  template<class T>
+  class ObjectPool: public ObjectPoolBase {
+    private:
+      struct FreeBlock {
+        FreeBlock* fNext;
+      };
+
+      /*
+       * Free blocks of one thread. Blocks left in the cache when the thread
+       * exits go back to the shared free list.
+       */
+      struct Cache {
+        FreeBlock* fHead;
+        unsigned int fSize;
+
+        Cache() :
+            fHead(nullptr), fSize(0) {
+        }
+
+        ~Cache() {
+          if (fHead != nullptr) GetInstance()->Spill(*this, fSize);
+        }
+      };
+
+      static thread_local Cache sCache;
+
+      Mutex fMutex;
+      FreeBlock* fFreeList;
+
+      ObjectPool() :
+          ObjectPoolBase(typeid(T).name()), fFreeList(nullptr) {
+      }
+
+      static ObjectPool* GetInstance() {
+        // Created on first use and kept until the process exits
+        static ObjectPool* instance = new ObjectPool();
+        return instance;
+      }
+
+      static size_t GetBlockSize() {
+        return (sizeof(T) > sizeof(FreeBlock)) ? sizeof(T) : sizeof(FreeBlock);
+      }
+
+      // Move up to half a cache of blocks from the shared free list to the cache
+      void Refill(Cache& pCache) {
+        fMutex.Lock();
+        while (fFreeList != nullptr && pCache.fSize < OBJECT_POOL_CACHE_SIZE / 2) {
+          FreeBlock* block = fFreeList;
+          fFreeList = block->fNext;
+          block->fNext = pCache.fHead;
+          pCache.fHead = block;
+          ++pCache.fSize;
+        }
+        fMutex.Unlock();
+      }
+
+      // Move the first pCount blocks of the cache to the shared free list
+      void Spill(Cache& pCache, unsigned int pCount) {
+        FreeBlock* first = pCache.fHead;
+        FreeBlock* last = first;
+        for (unsigned int i = 1; i < pCount; ++i) {
+          last = last->fNext;
+        }
+        pCache.fHead = last->fNext;
+        pCache.fSize -= pCount;
+        fMutex.Lock();
+        last->fNext = fFreeList;
+        fFreeList = first;
+        fMutex.Unlock();
+      }
+
+    public:
+      static void* Allocate() {
+        ObjectPool* pool = GetInstance();
+        Cache& cache = sCache;
+        if (cache.fHead == nullptr) pool->Refill(cache);
+        bool isHit = (cache.fHead != nullptr);
+        void* block;
+        if (isHit) {
+          block = cache.fHead;
+          cache.fHead = cache.fHead->fNext;
+          --cache.fSize;
+        } else {
+          block = ::operator new(GetBlockSize());
+        }
+        pool->CountAllocation(isHit);
+        return block;
+      }
+
+      static void Release(void* pBlock) {
+        ObjectPool* pool = GetInstance();
+        Cache& cache = sCache;
+        FreeBlock* block = static_cast<FreeBlock*>(pBlock);
+        block->fNext = cache.fHead;
+        cache.fHead = block;
+        ++cache.fSize;
+        // A thread that mostly deletes hands its surplus to the threads that mostly create
+        if (cache.fSize >= OBJECT_POOL_CACHE_SIZE) pool->Spill(cache, OBJECT_POOL_CACHE_SIZE / 2);
+        pool->CountRelease();
+      }
+  };
+
+  template<class T>
+  thread_local typename ObjectPool<T>::Cache ObjectPool<T>::sCache;
+
+  /*
+   * Base class taking the instances of T from ObjectPool<T>. Classes derived
+   * from T differ in size and are allocated on the heap as usual.
+   */
+  template<class T>
+  class Pooled {
+#ifdef OBJECT_POOLS
+    public:
+      static void* operator new(size_t pSize) {
+        if (pSize != sizeof(T)) return ::operator new(pSize);
+        return ObjectPool<T>::Allocate();
+      }
+
+      static void operator delete(void* pBlock, size_t pSize) {
+        if (pBlock == nullptr) return;
+        if (pSize != sizeof(T)) {
+          ::operator delete(pBlock);
+          return;
+        }
+        ObjectPool<T>::Release(pBlock);
+      }
+#endif
+  };
+}
+
+#endif /* OBJECTPOOL_H_ */
@@ -9,6 +9,7 @@
 #define _SEMAPHORE_H_
 
 #include <mutex>
+#include <chrono>
 #include <condition_variable>
 
 namespace pdesmas {
@@ -32,6 +33,22 @@ namespace pdesmas {
       --count_;
     }
 
+    // Decrement without blocking, false if the count is zero
+    bool TryWait() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (count_ == 0) return false;
+      --count_;
+      return true;
+    }
+
+    // Wait at most pTimeout microseconds, false if the wait timed out
+    bool WaitFor(unsigned long pTimeout) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (!cv_.wait_for(lock, std::chrono::microseconds(pTimeout), [=] { return count_ > 0; })) return false;
+      --count_;
+      return true;
+    }
+
     void Reset() {
       std::unique_lock<std::mutex> lock(mutex_);
       count_ = 1;
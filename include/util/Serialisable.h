@@ -9,7 +9,9 @@
 #define SERIALISABLE_H
 
 #include <iostream>
+#include <sstream>
 #include <limits>
+#include "WireBuffer.h"
 using std::ostream;
 using std::istream;
 using std::numeric_limits;
@@ -32,6 +34,24 @@ namespace pdesmas {
       virtual void Serialise(ostream&) const = 0;
       virtual void Deserialise(istream&) = 0;
 
+      /*
+       * Binary wire format. The default packs the text serialisation as a
+       * length-prefixed string, classes on the message path override these
+       * with a field-by-field encoding.
+       */
+      virtual void Pack(WireWriter& pWriter) const {
+        std::ostringstream out;
+        Serialise(out);
+        pWriter << out.str();
+      }
+
+      virtual void Unpack(WireReader& pReader) {
+        std::string text;
+        pReader >> text;
+        std::istringstream in(text);
+        Deserialise(in);
+      }
+
       istream& IgnoreTo(istream& pIstream, char pChar) {
         pIstream.ignore(numeric_limits<streamsize>::max(), pChar);
         return pIstream;
@@ -0,0 +1,174 @@
+/*
+ * WireBuffer.h
+ *
+ *  Created on: 17 Oct 2026
+ *
+ * Byte buffers for the binary wire format. WireWriter appends fields in
+ * native byte order (all LPs of a simulation run on the same architecture),
+ * WireReader reads them back in the same order. Strings are length-prefixed,
+ * enumerations are written as a single byte and Serialisable objects write
+ * themselves through Serialisable::Pack.
+ */
+
+#ifndef WIREBUFFER_H_
+#define WIREBUFFER_H_
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+namespace pdesmas {
+#define WIRE_FORMAT_VERSION 1
+
+  class Serialisable;
+
+  class WireWriter {
+    private:
+      std::vector<char> fBuffer;
+    public:
+      WireWriter() {
+        fBuffer.reserve(256);
+      }
+
+      const char* GetData() const {
+        return fBuffer.data();
+      }
+
+      size_t GetSize() const {
+        return fBuffer.size();
+      }
+
+      void Clear() {
+        fBuffer.clear();
+      }
+
+      void Write(const void* pData, size_t pLength) {
+        const char* data = static_cast<const char*>(pData);
+        fBuffer.insert(fBuffer.end(), data, data + pLength);
+      }
+
+      // Overwrite bytes already written, used to fill in length prefixes
+      void WriteAt(size_t pOffset, const void* pData, size_t pLength) {
+        memcpy(&fBuffer[pOffset], pData, pLength);
+      }
+
+      template<typename T>
+      typename std::enable_if<std::is_arithmetic<T>::value, WireWriter&>::type operator<<(const T& pValue) {
+        Write(&pValue, sizeof(T));
+        return *this;
+      }
+
+      template<typename T>
+      typename std::enable_if<std::is_enum<T>::value, WireWriter&>::type operator<<(const T& pValue) {
+        unsigned char value = static_cast<unsigned char>(pValue);
+        Write(&value, sizeof(value));
+        return *this;
+      }
+
+      template<typename T>
+      typename std::enable_if<std::is_base_of<Serialisable, T>::value, WireWriter&>::type operator<<(const T& pValue) {
+        pValue.Pack(*this);
+        return *this;
+      }
+
+      WireWriter& operator<<(const std::string& pValue) {
+        unsigned int length = pValue.size();
+        Write(&length, sizeof(length));
+        Write(pValue.data(), length);
+        return *this;
+      }
+  };
+
+  class WireReader {
+    private:
+      const char* fBuffer;
+      size_t fLength;
+      size_t fPosition;
+      bool fFailed;
+    public:
+      WireReader(const char* pBuffer, size_t pLength) :
+          fBuffer(pBuffer), fLength(pLength), fPosition(0), fFailed(false) {
+      }
+
+      // False once a read ran past the end of the buffer
+      bool IsGood() const {
+        return !fFailed;
+      }
+
+      size_t GetPosition() const {
+        return fPosition;
+      }
+
+      size_t GetRemaining() const {
+        return fLength - fPosition;
+      }
+
+      const char* GetData() const {
+        return fBuffer;
+      }
+
+      bool Read(void* pData, size_t pLength) {
+        if (pLength > GetRemaining()) {
+          fFailed = true;
+          fPosition = fLength;
+          memset(pData, 0, pLength);
+          return false;
+        }
+        memcpy(pData, fBuffer + fPosition, pLength);
+        fPosition += pLength;
+        return true;
+      }
+
+      // Read without consuming, pOffset is relative to the start of the buffer
+      bool PeekAt(size_t pOffset, void* pData, size_t pLength) const {
+        if (pOffset + pLength > fLength) return false;
+        memcpy(pData, fBuffer + pOffset, pLength);
+        return true;
+      }
+
+      void SkipTo(size_t pPosition) {
+        if (pPosition > fLength) {
+          fFailed = true;
+          pPosition = fLength;
+        }
+        if (pPosition > fPosition) fPosition = pPosition;
+      }
+
+      template<typename T>
+      typename std::enable_if<std::is_arithmetic<T>::value, WireReader&>::type operator>>(T& pValue) {
+        Read(&pValue, sizeof(T));
+        return *this;
+      }
+
+      template<typename T>
+      typename std::enable_if<std::is_enum<T>::value, WireReader&>::type operator>>(T& pValue) {
+        unsigned char value;
+        Read(&value, sizeof(value));
+        pValue = static_cast<T>(value);
+        return *this;
+      }
+
+      template<typename T>
+      typename std::enable_if<std::is_base_of<Serialisable, T>::value, WireReader&>::type operator>>(T& pValue) {
+        pValue.Unpack(*this);
+        return *this;
+      }
+
+      WireReader& operator>>(std::string& pValue) {
+        unsigned int length;
+        Read(&length, sizeof(length));
+        if (length > GetRemaining()) {
+          fFailed = true;
+          fPosition = fLength;
+          pValue.clear();
+          return *this;
+        }
+        pValue.assign(fBuffer + fPosition, length);
+        fPosition += length;
+        return *this;
+      }
+  };
+}
+
+#endif /* WIREBUFFER_H_ */
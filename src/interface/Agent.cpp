@@ -12,6 +12,8 @@
 #include "Agent.h"
 #include "SsvId.h"
 #include "SingleReadMessage.h"
+#include "MultiReadMessage.h"
+#include "MultiWriteMessage.h"
 #include "Helper.h"
 #include "Log.h"
 #include "GvtRequestMessage.h"
@@ -104,6 +106,52 @@ Agent::SendWriteMessageAndGetResponse(unsigned long pVariableId, T pValue, unsig
 
 }
 
+const MultiReadResponseMessage *
+Agent::SendMultiReadMessageAndGetResponse(const set<unsigned long> &pVariableIds, unsigned long pTime) {
+  MultiReadMessage *multiReadMessage = new MultiReadMessage();
+  multiReadMessage->SetOrigin(attached_alp_->GetRank());
+  multiReadMessage->SetDestination(attached_alp_->GetParentClp());
+  multiReadMessage->SetTimestamp(pTime);
+  // Mattern colour set by GVT calculator
+  multiReadMessage->SetNumberOfHops(0);
+  multiReadMessage->SetIdentifier(attached_alp_->GetNewMessageId());
+  multiReadMessage->SetOriginalAgent(agent_identifier_);
+  for (unsigned long variableId : pVariableIds) {
+    multiReadMessage->AddSsvId(SsvId(variableId));
+  }
+  multiReadMessage->SendToLp(attached_alp_);
+  WaitUntilMessageArrive();
+  const AbstractMessage *ret = attached_alp_->GetResponseMessage(agent_identifier_.GetId());
+  if (ret->GetType() != MULTIREADRESPONSEMESSAGE) {
+    spdlog::critical("Expecting MULTIREADRESPONSEMESSAGE, but get {}", ret->GetType());
+    exit(1);
+  }
+  return (const MultiReadResponseMessage *) ret;
+}
+
+template<typename T>
+const MultiWriteResponseMessage *
+Agent::SendMultiWriteMessageAndGetResponse(const map<unsigned long, T> &pVariableValues, unsigned long pTime) {
+  MultiWriteMessage *multiWriteMessage = new MultiWriteMessage();
+  multiWriteMessage->SetOrigin(attached_alp_->GetRank());
+  multiWriteMessage->SetDestination(attached_alp_->GetParentClp());
+  multiWriteMessage->SetTimestamp(pTime);
+  // Mattern colour set by GVT Calculator
+  multiWriteMessage->SetNumberOfHops(0);
+  multiWriteMessage->SetIdentifier(attached_alp_->GetNewMessageId());
+  multiWriteMessage->SetOriginalAgent(agent_identifier_);
+  for (const pair<const unsigned long, T> &variableValue : pVariableValues) {
+    multiWriteMessage->AddSsvIdValue(SsvId(variableValue.first), new Value<T>(variableValue.second));
+  }
+  multiWriteMessage->SendToLp(attached_alp_);
+  WaitUntilMessageArrive();
+  const AbstractMessage *ret = attached_alp_->GetResponseMessage(agent_identifier_.GetId());
+  if (ret->GetType() != MULTIWRITERESPONSEMESSAGE) {
+    spdlog::critical("Expecting MULTIWRITERESPONSEMESSAGE, but get {}", ret->GetType());
+    exit(1);
+  }
+  return (const MultiWriteResponseMessage *) ret;
+}
 
 const RangeQueryMessage *
 Agent::SendRangeQueryPointMessageAndGetResponse(unsigned long pTime, const Point pStartValue, const Point pEndValue) {
@@ -209,15 +257,7 @@ const Point Agent::ReadPoint(unsigned long variable_id, unsigned long timestamp)
 //  spdlog::debug(out.str());
   assert(ret != nullptr);
   assert(ret->GetValue() != nullptr);
-
-  Value<Point> *p = new Value<Point>();
-//spdlog::debug(p->GetValueString());
-  auto p_v = ret->GetValue();
-
-  auto s_v = p_v->GetValueString();
-  p->SetValue(s_v);
-  //auto v = (dynamic_cast<const Value<Point> *>(ret->GetValue()))->GetValue();
-  auto v = p->GetValue();
+  auto v = static_cast<const Value<Point> *>(ret->GetValue())->GetValue();
 
   this->SetLVT(timestamp + 1);
   return v;
@@ -244,7 +284,7 @@ const Point Agent::ReadPrivatePoint(unsigned long variable_id) {
 }
 
 const string Agent::ReadPrivateString(unsigned long variable_id) {
-  return std::__cxx11::string();
+  return string();
 }
 
 bool Agent::WritePrivateInt(unsigned long variable_id, int v) {
@@ -313,6 +353,46 @@ Agent::RangeQueryPoint(const Point start, const Point end, unsigned long timesta
   return r;
 }
 
+template<typename T>
+const map<unsigned long, T> Agent::ReadMany(const vector<unsigned long> &variable_ids, unsigned long timestamp) {
+  assert(timestamp >= this->GetLVT());
+  map<unsigned long, T> values;
+  // Each variable is read once, no CLP would answer an empty batch
+  set<unsigned long> variable_id_set(variable_ids.begin(), variable_ids.end());
+  if (!variable_id_set.empty()) {
+    const MultiReadResponseMessage *ret = SendMultiReadMessageAndGetResponse(variable_id_set, timestamp);
+    for (const pair<SsvId, shared_ptr<const AbstractValue> > &ssvIdValue : ret->GetSsvIdValueList()) {
+      values[ssvIdValue.first.id()] = static_cast<const Value<T> *>(ssvIdValue.second.get())->GetValue();
+    }
+  }
+  this->SetLVT(timestamp + 1);
+  return values;
+}
+
+template<typename T>
+bool Agent::WriteMany(const map<unsigned long, T> &variable_values, unsigned long timestamp) {
+  assert(timestamp >= this->GetLVT());
+  bool is_success = true;
+  if (!variable_values.empty()) {
+    const MultiWriteResponseMessage *ret = SendMultiWriteMessageAndGetResponse<T>(variable_values, timestamp);
+    for (const pair<const SsvId, WriteStatus> &ssvIdWriteStatus : ret->GetSsvIdWriteStatusMap()) {
+      if (ssvIdWriteStatus.second != writeSUCCESS) is_success = false;
+    }
+  }
+  this->SetLVT(timestamp + 1);
+  return is_success;
+}
+
+// The value types agents read and write in batches
+template const map<unsigned long, int> Agent::ReadMany<int>(const vector<unsigned long> &, unsigned long);
+template const map<unsigned long, double> Agent::ReadMany<double>(const vector<unsigned long> &, unsigned long);
+template const map<unsigned long, Point> Agent::ReadMany<Point>(const vector<unsigned long> &, unsigned long);
+template const map<unsigned long, string> Agent::ReadMany<string>(const vector<unsigned long> &, unsigned long);
+template bool Agent::WriteMany<int>(const map<unsigned long, int> &, unsigned long);
+template bool Agent::WriteMany<double>(const map<unsigned long, double> &, unsigned long);
+template bool Agent::WriteMany<Point>(const map<unsigned long, Point> &, unsigned long);
+template bool Agent::WriteMany<string>(const map<unsigned long, string> &, unsigned long);
+
 void Agent::SetMessageArriveFlag() {
   message_ready_ = true;
 }
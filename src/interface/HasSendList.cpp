@@ -69,8 +69,7 @@ void HasSendList::ClearSendList(unsigned long pTime) {
   for (list<SharedStateMessage *>::iterator iter = fSendList.begin(); iter
                                                                       != fSendList.end();) {
     if ((*iter)->GetTimestamp() < pTime) {
-      // I don't need to free the value memory for WriteMessages here because that's already done
-      // in the SendThread!
+      // WriteMessages in the send list hold no value, AddToSendList drops it
       delete *iter;
       iter = fSendList.erase(iter);
     } else iter++;
@@ -86,6 +85,8 @@ void HasSendList::AddToSendList(const SingleReadMessage *pSingleReadMessage) {
 void HasSendList::AddToSendList(const WriteMessage *pWriteMessage) {
   WriteMessage *copyMessage = new WriteMessage;
   *copyMessage = *pWriteMessage;
+  // Only needed to cancel the write, do not keep the value alive until GVT passes it
+  copyMessage->ClearValue();
   fSendList.push_back(copyMessage);
 }
 
@@ -95,6 +96,49 @@ void HasSendList::AddToSendList(const RangeQueryMessage *pRangeQueryMessage) {
   fSendList.push_back(copyMessage);
 }
 
+void HasSendList::AddToSendList(const MultiReadMessage *pMultiReadMessage) {
+  for (const SsvId &ssvId : pMultiReadMessage->GetSsvIdList()) {
+    SingleReadMessage *singleReadMessage = new SingleReadMessage;
+    singleReadMessage->SetOrigin(pMultiReadMessage->GetOrigin());
+    singleReadMessage->SetDestination(pMultiReadMessage->GetDestination());
+    singleReadMessage->SetTimestamp(pMultiReadMessage->GetTimestamp());
+    singleReadMessage->SetMatternColour(pMultiReadMessage->GetMatternColour());
+    singleReadMessage->SetNumberOfHops(pMultiReadMessage->GetNumberOfHops());
+    singleReadMessage->SetIdentifier(pMultiReadMessage->GetIdentifier());
+    singleReadMessage->SetOriginalAgent(pMultiReadMessage->GetOriginalAgent());
+    singleReadMessage->SetSsvId(ssvId);
+    fSendList.push_back(singleReadMessage);
+  }
+}
+
+void HasSendList::AddToSendList(const MultiWriteMessage *pMultiWriteMessage) {
+  for (const pair<SsvId, shared_ptr<const AbstractValue> > &ssvIdValue : pMultiWriteMessage->GetSsvIdValueList()) {
+    // No value, as for a single write
+    WriteMessage *writeMessage = new WriteMessage;
+    writeMessage->SetOrigin(pMultiWriteMessage->GetOrigin());
+    writeMessage->SetDestination(pMultiWriteMessage->GetDestination());
+    writeMessage->SetTimestamp(pMultiWriteMessage->GetTimestamp());
+    writeMessage->SetMatternColour(pMultiWriteMessage->GetMatternColour());
+    writeMessage->SetNumberOfHops(pMultiWriteMessage->GetNumberOfHops());
+    writeMessage->SetIdentifier(pMultiWriteMessage->GetIdentifier());
+    writeMessage->SetOriginalAgent(pMultiWriteMessage->GetOriginalAgent());
+    writeMessage->SetSsvId(ssvIdValue.first);
+    fSendList.push_back(writeMessage);
+  }
+}
+
+bool HasSendList::RemoveFromSendList(unsigned long pMessageId, const SsvId &pSsvId) {
+  for (list<SharedStateMessage *>::iterator iter = fSendList.begin(); iter != fSendList.end(); ++iter) {
+    if ((*iter)->GetIdentifier() == pMessageId && (*iter)->GetType() == WRITEMESSAGE
+        && static_cast<WriteMessage *> (*iter)->GetSsvId() == pSsvId) {
+      delete *iter;
+      fSendList.erase(iter);
+      return true;
+    }
+  }
+  return false;
+}
+
 bool HasSendList::RemoveFromSendList(unsigned long message_id) {
   for (auto iter = fSendList.begin(); iter != fSendList.end(); ++iter) {
     if ((*iter)->GetIdentifier() == message_id) {
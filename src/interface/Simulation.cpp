@@ -2,8 +2,11 @@
 // Created by pill on 19-4-23.
 //
 
+#include <mpi.h>
 #include <parse/Initialisor.h>
 #include "Simulation.h"
+#include "ThreadedNetwork.h"
+#include "ObjectPool.h"
 #include <spdlog/spdlog.h>
 
 void Simulation::Construct(int number_of_clp, int number_of_alp, unsigned long start_time, unsigned long end_time) {
@@ -11,12 +14,15 @@ void Simulation::Construct(int number_of_clp, int number_of_alp, unsigned long s
   number_of_alp_ = number_of_alp;
   start_time_ = start_time;
   end_time_ = end_time;
-  int providedThreadSupport;
-  MPI_Init_thread(nullptr, nullptr, MPI_THREAD_SERIALIZED, &providedThreadSupport);
-  assert(providedThreadSupport == MPI_THREAD_SERIALIZED);
-  MPI_Comm_size(MPI_COMM_WORLD, &comm_size_);
-  MPI_Comm_rank(MPI_COMM_WORLD, &comm_rank_);
-  spdlog::info("MPI Process up ,rank {}, pid {}", comm_rank_, getpid());
+  ThreadedNetwork *threadedNetwork = ThreadedNetwork::GetInstance();
+  if (threadedNetwork != nullptr) {
+    // One of the LP threads of Simulation::RunInProcess
+    comm_size_ = threadedNetwork->GetSize();
+    comm_rank_ = threadedNetwork->GetRank();
+    spdlog::info("In-process LP up, rank {}", comm_rank_);
+  } else {
+    InitialiseMpi();
+  }
   for (int i = 0; i < number_of_alp + number_of_clp; ++i) {
     topology_[i] = new DummyNode();
   }
@@ -25,6 +31,40 @@ void Simulation::Construct(int number_of_clp, int number_of_alp, unsigned long s
 
 }
 
+void Simulation::InitialiseMpi() {
+  int providedThreadSupport;
+#ifdef MULTIPLE_THREAD_MPI
+  MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &providedThreadSupport);
+  if (providedThreadSupport < MPI_THREAD_MULTIPLE) {
+    spdlog::warn("MPI_THREAD_MULTIPLE not provided, falling back to serialised MPI calls");
+  }
+#else
+  MPI_Init_thread(nullptr, nullptr, MPI_THREAD_SERIALIZED, &providedThreadSupport);
+#endif
+  assert(providedThreadSupport >= MPI_THREAD_SERIALIZED);
+  MPI_Comm_size(MPI_COMM_WORLD, &comm_size_);
+  MPI_Comm_rank(MPI_COMM_WORLD, &comm_rank_);
+  spdlog::info("MPI Process up ,rank {}, pid {}", comm_rank_, getpid());
+}
+
+int Simulation::RunInProcess(int number_of_lp, int (*program)(int, char **), int argc, char **argv) {
+  // Register all message and value types up front, the LP threads only look them up
+  Initialisor(0, 0, 0, 0).InitEverything();
+  int returnValue = ThreadedNetwork::Run(number_of_lp, program, argc, argv);
+  // The LP threads share the pools, report them once
+  ObjectPoolBase::LogStatistics();
+  return returnValue;
+}
+
+void Simulation::Barrier() {
+  ThreadedNetwork *threadedNetwork = ThreadedNetwork::GetInstance();
+  if (threadedNetwork != nullptr) {
+    threadedNetwork->Barrier();
+  } else {
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+}
+
 Simulation &Simulation::set_topology(const string &topo) {
   return *this;
 }
@@ -47,7 +87,7 @@ Simulation &Simulation::attach_alp_to_clp(int alp_rank, int clp_rank) {
 
 
 void Simulation::Initialise() {
-  MPI_Barrier(MPI_COMM_WORLD);
+  Barrier();
   initialisor_->Finalise();
   int clp_max_rank = number_of_clp_ - 1;
   int alp_max_rank = clp_max_rank + number_of_alp_;
@@ -57,6 +97,10 @@ void Simulation::Initialise() {
     clp_ = new Clp(comm_rank_, comm_size_, number_of_clp_, number_of_alp_, start_time_, end_time_, initialisor_);
   } else if (comm_rank_ <= alp_max_rank) { // is alp
     alp_ = new Alp(comm_rank_, comm_size_, number_of_clp_, number_of_alp_, start_time_, end_time_, initialisor_);
+  } else if (ThreadedNetwork::GetInstance() != nullptr) {
+    // Exiting would take the other LP threads down, and they would wait for this one in every barrier
+    spdlog::critical("Unused in-process LP, rank={0}, run as many LPs as CLPs and ALPs", comm_rank_);
+    exit(1);
   } else {
     spdlog::warn("Unused process, rank={0}", comm_rank_);
     Finalise();
@@ -65,7 +109,7 @@ void Simulation::Initialise() {
 }
 
 void Simulation::Run() {
-  MPI_Barrier(MPI_COMM_WORLD);
+  Barrier();
 
   if (this->alp_ != nullptr) {
 
@@ -83,7 +127,11 @@ void Simulation::Run() {
 }
 
 void Simulation::Finalise() {
-  MPI_Finalize();
+  // In process there is no MPI to finalise, and RunInProcess reports the pools
+  if (ThreadedNetwork::GetInstance() == nullptr) {
+    ObjectPoolBase::LogStatistics();
+    MPI_Finalize();
+  }
 }
 
 
@@ -48,13 +48,13 @@ Alp::Alp(unsigned int pRank, unsigned int pCommSize,
     exit(1);
   }
 
-  fMPIInterface = new MpiInterface(this, this);
+  fTransport = Transport::Create(this);
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  fTransport->Barrier();
 
-  fMPIInterface->Signal();
+  fTransport->Signal();
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  fTransport->Barrier();
 }
 
 //Semaphore &Alp::GetWaitingSemaphore(unsigned long agent_id) {
@@ -94,17 +94,23 @@ bool Alp::AddAgent(Agent *agent) {
   agent_lvt_map_[agent_id] = 0;
   agent_lvt_history_map_[agent_id] = list<unsigned long>{0};
   agent_cancel_flag_map_[agent_id] = false;
+  agent_response_ssv_count_map_[agent_id] = 0;
+  agent_partial_response_map_[agent_id] = nullptr;
   agent_rollback_reentry_lock_map_[agent_id] = Mutex(NORMAL);
   agent->attach_alp(this);
   return true;
 }
 
-void Alp::Send() {
-  AbstractMessage *message;
-  if (!fSendControlMessageQueue->IsEmpty()) {
-    message = fSendControlMessageQueue->DequeueMessage();
-  } else if (!fSendMessageQueue->IsEmpty()) {
+bool Alp::Send() {
+  // Control messages go first and are sent as is
+  AbstractMessage *message = fSendControlMessageQueue->DequeueMessage();
+  if (NULL == message) {
     message = fSendMessageQueue->DequeueMessage();
+    if (NULL == message) {
+      // A message signal was issues, but no message remains to be send, most probably because
+      // the message was removed because of a rollback.
+      return false;
+    }
     switch (message->GetType()) {
       case SINGLEREADMESSAGE: {
         SingleReadMessage *singleReadMessage = static_cast<SingleReadMessage *>(message);
@@ -142,30 +148,51 @@ void Alp::Send() {
       case RANGEQUERYANTIMESSAGE :
         PreProcessSendMessage(static_cast<RangeQueryAntiMessage *> (message));
         break;
+      case MULTIREADMESSAGE: {
+        MultiReadMessage *multiReadMessage = static_cast<MultiReadMessage *>(message);
+        AddToSendList(multiReadMessage);
+        PreProcessSendMessage(multiReadMessage);
+        unsigned long agent_id = multiReadMessage->GetOriginalAgent().GetId();
+        agent_response_ssv_count_map_[agent_id] = multiReadMessage->GetSsvIdList().size();
+        agent_response_message_id_map_[agent_id] = multiReadMessage->GetIdentifier();
+      }
+        break;
+      case MULTIWRITEMESSAGE: {
+        MultiWriteMessage *multiWriteMessage = static_cast<MultiWriteMessage *>(message);
+        AddToSendList(multiWriteMessage);
+        PreProcessSendMessage(multiWriteMessage);
+        unsigned long agent_id = multiWriteMessage->GetOriginalAgent().GetId();
+        agent_response_ssv_count_map_[agent_id] = multiWriteMessage->GetSsvIdValueList().size();
+        agent_response_message_id_map_[agent_id] = multiWriteMessage->GetIdentifier();
+      }
+        break;
       case ROLLBACKMESSAGE :
         PreProcessSendMessage(static_cast<RollbackMessage *> (message));
         break;
       default: // skip
         break;
     }
-  } else {
-    // A message signal was issues, but no message remains to be send, most probably because
-    // the message was removed because of a rollback.
-    return;
   }
-  ostringstream out;
-  message->Serialise(out);
-  spdlog::debug("ALP send message: {}", out.str());
-  fMPIInterface->Send(message);
+  if (spdlog::default_logger_raw()->should_log(spdlog::level::debug)) {
+    ostringstream out;
+    message->Serialise(out);
+    spdlog::debug("ALP send message: {}", out.str());
+  }
+  fTransport->Send(message);
+  return true;
 }
 
 void Alp::Receive() {
-  // Fetch received message from the receive queue
-  AbstractMessage *message = fReceiveMessageQueue->DequeueMessage();
+  // Fetch received message from the receive queues, control messages first
+  AbstractMessage *message = fReceiveControlMessageQueue->DequeueMessage();
+  if (NULL == message) message = fReceiveMessageQueue->DequeueMessage();
+  if (NULL == message) return;
   //spdlog::debug("Message arrived, rank {0}, type {1}", this->GetRank(), message->GetType());
-  ostringstream out;
-  message->Serialise(out);
-  spdlog::debug("ALP receive message: {}", out.str());
+  if (spdlog::default_logger_raw()->should_log(spdlog::level::debug)) {
+    ostringstream out;
+    message->Serialise(out);
+    spdlog::debug("ALP receive message: {}", out.str());
+  }
   fProcessMessageMutex.Lock();
   switch (message->GetType()) {
     case SINGLEREADRESPONSEMESSAGE: {
@@ -180,6 +207,18 @@ void Alp::Receive() {
       ProcessMessage(writeResponseMessage);
     }
       break;
+    case MULTIREADRESPONSEMESSAGE: {
+      MultiReadResponseMessage *multiReadResponseMessage = dynamic_cast<MultiReadResponseMessage *>(message);
+      PreProcessReceiveMessage(multiReadResponseMessage);
+      ProcessMessage(multiReadResponseMessage);
+    }
+      break;
+    case MULTIWRITERESPONSEMESSAGE: {
+      MultiWriteResponseMessage *multiWriteResponseMessage = dynamic_cast<MultiWriteResponseMessage *>(message);
+      PreProcessReceiveMessage(multiWriteResponseMessage);
+      ProcessMessage(multiWriteResponseMessage);
+    }
+      break;
     case RANGEQUERYMESSAGE: {
       RangeQueryMessage *rangeQueryMessage = dynamic_cast<RangeQueryMessage *>(message);
       PreProcessReceiveMessage(rangeQueryMessage);
@@ -264,6 +303,71 @@ void Alp::ProcessMessage(const WriteResponseMessage *pWriteResponseMessage) {
   }
 }
 
+void Alp::ProcessMessage(MultiReadResponseMessage *pMultiReadResponseMessage) {
+  unsigned long agent_id = pMultiReadResponseMessage->GetOriginalAgent().GetId();
+  if (agent_response_message_id_map_[agent_id] != pMultiReadResponseMessage->GetIdentifier()) {
+    spdlog::debug("Alp::ProcessMessage(MultiReadResponseMessage): Message discarded, id {}, agent {} waiting for {}",
+                  pMultiReadResponseMessage->GetIdentifier(), agent_id, agent_response_message_id_map_[agent_id]);
+    delete pMultiReadResponseMessage;
+    return;
+  }
+  // Every CLP holding part of the variables responds, combine their responses into the first one
+  ResponseMessage *&partialResponseMessage = agent_partial_response_map_[agent_id];
+  if (partialResponseMessage != nullptr) {
+    MultiReadResponseMessage *combinedResponseMessage = static_cast<MultiReadResponseMessage *>(partialResponseMessage);
+    for (const pair<SsvId, shared_ptr<const AbstractValue> > &ssvIdValue
+        : pMultiReadResponseMessage->GetSsvIdValueList()) {
+      combinedResponseMessage->AddSsvIdValue(ssvIdValue.first, ssvIdValue.second);
+    }
+    delete pMultiReadResponseMessage;
+    pMultiReadResponseMessage = combinedResponseMessage;
+  }
+  if (pMultiReadResponseMessage->GetSsvIdValueList().size() < agent_response_ssv_count_map_[agent_id]) {
+    partialResponseMessage = pMultiReadResponseMessage;
+    return;
+  }
+  partialResponseMessage = nullptr;
+  agent_response_map_[agent_id] = pMultiReadResponseMessage;
+  this->GetAgent(agent_id)->SetMessageArriveFlag();
+}
+
+void Alp::ProcessMessage(MultiWriteResponseMessage *pMultiWriteResponseMessage) {
+  unsigned long agent_id = pMultiWriteResponseMessage->GetOriginalAgent().GetId();
+  // The failed writes made no write period, so there is nothing to cancel for them
+  for (const pair<const SsvId, WriteStatus> &ssvIdWriteStatus : pMultiWriteResponseMessage->GetSsvIdWriteStatusMap()) {
+    if (ssvIdWriteStatus.second == writeSUCCESS) continue;
+    if (!RemoveFromSendList(pMultiWriteResponseMessage->GetIdentifier(), ssvIdWriteStatus.first)) {
+      spdlog::error("RemoveFromSendList({}, {}) remove failed!", pMultiWriteResponseMessage->GetIdentifier(),
+                    ssvIdWriteStatus.first.id());
+    }
+  }
+  if (agent_response_message_id_map_[agent_id] != pMultiWriteResponseMessage->GetIdentifier()) {
+    spdlog::debug("Alp::ProcessMessage(MultiWriteResponseMessage): Message discarded, id {}, agent {} waiting for {}",
+                  pMultiWriteResponseMessage->GetIdentifier(), agent_id, agent_response_message_id_map_[agent_id]);
+    delete pMultiWriteResponseMessage;
+    return;
+  }
+  // Every CLP holding part of the variables responds, combine their responses into the first one
+  ResponseMessage *&partialResponseMessage = agent_partial_response_map_[agent_id];
+  if (partialResponseMessage != nullptr) {
+    MultiWriteResponseMessage *combinedResponseMessage =
+        static_cast<MultiWriteResponseMessage *>(partialResponseMessage);
+    for (const pair<const SsvId, WriteStatus> &ssvIdWriteStatus
+        : pMultiWriteResponseMessage->GetSsvIdWriteStatusMap()) {
+      combinedResponseMessage->SetSsvIdWriteStatus(ssvIdWriteStatus.first, ssvIdWriteStatus.second);
+    }
+    delete pMultiWriteResponseMessage;
+    pMultiWriteResponseMessage = combinedResponseMessage;
+  }
+  if (pMultiWriteResponseMessage->GetSsvIdWriteStatusMap().size() < agent_response_ssv_count_map_[agent_id]) {
+    partialResponseMessage = pMultiWriteResponseMessage;
+    return;
+  }
+  partialResponseMessage = nullptr;
+  agent_response_map_[agent_id] = pMultiWriteResponseMessage;
+  this->GetAgent(agent_id)->SetMessageArriveFlag();
+}
+
 void Alp::ProcessMessage(const RangeQueryMessage *pRangeQueryMessage) {
   //unsigned long message_id = pRangeQueryMessage->GetIdentifier();
   unsigned long agent_id = pRangeQueryMessage->GetOriginalAgent().GetId();
@@ -452,6 +556,9 @@ bool Alp::ProcessRollback(const RollbackMessage *pRollbackMessage) {
   SetCancelFlag(agent_id, false);
   agent_response_map_[agent_id] = nullptr;
   agent_response_message_id_map_[agent_id] = 0;
+  // Drop the part of a batch response that arrived before the rollback
+  delete agent_partial_response_map_[agent_id];
+  agent_partial_response_map_[agent_id] = nullptr;
   // restart agent
   spdlog::debug("Agent restarting");
   agent->Restart();
@@ -554,8 +661,9 @@ void Alp::Finalise() {
   SendEndMessage();
 
 
-  fMPIInterface->StopSimulation();
-  fMPIInterface->Join();
+  fTransport->StopSimulation();
+  fTransport->Join();
+  LogReceiveQueueStatistics();
 }
 
 void Alp::StartAllAgents() {
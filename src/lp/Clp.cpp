@@ -1,3 +1,4 @@
+#include <unistd.h>
 #include "Clp.h"
 #include "Value.h"
 #include "SingleReadResponseMessage.h"
@@ -6,6 +7,8 @@
 #include "LoadBalancingMessage.h"
 #include "StateMigrationMessage.h"
 #include "WriteResponseMessage.h"
+#include "MultiReadResponseMessage.h"
+#include "MultiWriteResponseMessage.h"
 #include "assert.h"
 #include "Log.h"
 #include "Helper.h"
@@ -37,10 +40,21 @@ Clp::Clp(unsigned int pRank, unsigned int pCommSize,
 
   fGVTCalculator = new GvtCalculator(this);
 
+#ifdef CLP_SHARDS
+  for (unsigned int shard = 0; shard < CLP_SHARDS; ++shard) {
+    fShards.push_back(new ClpShard(this));
+    fShards.back()->GetSharedState().ShareWithShards(&fShardPointBounds, &fShardMutex);
+  }
+#endif
+
 #ifdef SSV_LOCALISATION
   fAccessCostCalculator
       = new AccessCostCalculator(GetRank(), GetNumberOfClps());
+#ifdef CLP_SHARDS
+  for (ClpShard *shard : fShards) shard->GetSharedState().SetAccessCostCalculator(fAccessCostCalculator);
+#else
   fSharedState.SetAccessCostCalculator(fAccessCostCalculator);
+#endif
   fStopLoadBalanceProcessing = false;
 #endif
 
@@ -56,23 +70,31 @@ Clp::Clp(unsigned int pRank, unsigned int pCommSize,
 
   fRouter = new Router(GetRank(), GetNumberOfClps(), initialisor);
 
-  fMPIInterface = new MpiInterface(this, this);
+#ifdef CLP_ANNIHILATION
+  fReceiveMessageQueue->EnableAnnihilation();
+#endif
+
+  fTransport = Transport::Create(this);
 
 #ifdef RANGE_QUERIES
   fRangeRoutingTable = vector<RangeRoutingTable *>(DIRECTION_SIZE);
   for (int ports = 0; ports < DIRECTION_SIZE; ++ports)
     fRangeRoutingTable[ports] = new RangeRoutingTable();
+#ifdef CLP_SHARDS
+  for (ClpShard *shard : fShards) shard->GetSharedState().SetRangeRoutingTable(fRangeRoutingTable[0]);
+#else
   fSharedState.SetRangeRoutingTable(fRangeRoutingTable[0]);
+#endif
   fRangeTracker = new RangeTracker();
   InitialisePortRanges(initialisor);
 #endif
 
   // Wait for all CLPs and ALPs to come online
-  MPI_Barrier(MPI_COMM_WORLD);
+  fTransport->Barrier();
   // Initialise the MPI connections
-  fMPIInterface->Signal();
+  fTransport->Signal();
   // Wait for all MPI connections to come online
-  MPI_Barrier(MPI_COMM_WORLD);
+  fTransport->Barrier();
 }
 
 void Clp::AddSSV(const SsvId &pSSVID, const AbstractValue *pValue) {
@@ -83,15 +105,54 @@ void Clp::AddSSV(const SsvId &pSSVID, const AbstractValue *pValue) {
    * initialise the first write period of an SSV.
    */
   // TODO Fix initialisation of the first write period
-  fSharedState.Add(pSSVID, pValue, fStartTime, LpId(0, 0));
+  GetSharedState(pSSVID).Add(pSSVID, pValue, fStartTime, LpId(0, 0));
+}
+
+SharedState &Clp::GetSharedState(const SsvId &pSSVID) {
+#ifdef CLP_SHARDS
+  return GetShard(pSSVID)->GetSharedState();
+#else
+  return fSharedState;
+#endif
 }
 
+#ifdef CLP_SHARDS
+
+ClpShard *Clp::GetShard(const SsvId &pSSVID) const {
+  // SSV ids often come in sequences or strides, spread them by the high bits of a multiplicative hash
+  unsigned long hash = (pSSVID.id() * 0x9e3779b97f4a7c15UL) >> 32;
+  return fShards[hash % fShards.size()];
+}
+
+void Clp::WaitForShards() {
+  for (ClpShard *shard : fShards) shard->WaitUntilIdle();
+}
+
+#endif
+
 void Clp::SetGvt(unsigned long pGVT) {
+#ifdef CLP_SHARDS
+  // The shared state only changes below while the shards are idle
+  WaitForShards();
+#endif
   // Set GVT
   fGVT = pGVT;
   // Remove write periods before GVT
   spdlog::debug("Clp {}, SetGvt({}), remove write periods", GetRank(), fGVT);
+#ifdef CLP_SHARDS
+  unsigned long valueSize = 0;
+  unsigned long versionCount = 0;
+  for (ClpShard *shard : fShards) {
+    shard->GetSharedState().RemoveWritePeriods(fGVT);
+    valueSize += shard->GetSharedState().GetValueSize();
+    versionCount += shard->GetSharedState().GetVersionCount();
+  }
+#else
   fSharedState.RemoveWritePeriods(fGVT);
+  unsigned long valueSize = fSharedState.GetValueSize();
+  unsigned long versionCount = fSharedState.GetVersionCount();
+#endif
+  spdlog::warn("LOGMEM clp {} gvt {} LEN {} versions {}", GetRank(), fGVT, valueSize, versionCount);
 #ifdef RANGE_QUERIES
   // Clear range periods
   for (int ports = 0; ports < DIRECTION_SIZE; ports++)
@@ -118,16 +179,11 @@ void Clp::SetGvt(unsigned long pGVT) {
   }
 }
 
-void Clp::Send() {
-  AbstractMessage *sendMessage = NULL;
-  if (!fSendLoadBalancingMessageQueue->IsEmpty()) {
-    sendMessage = fSendLoadBalancingMessageQueue->DequeueMessage();
-  } else if (!fSendControlMessageQueue->IsEmpty()) {
-    sendMessage = fSendControlMessageQueue->DequeueMessage();
-  } else if (!fSendMessageQueue->IsEmpty()) {
-    sendMessage = fSendMessageQueue->DequeueMessage();
-  }
-  if (NULL == sendMessage) return;
+bool Clp::Send() {
+  AbstractMessage *sendMessage = fSendLoadBalancingMessageQueue->DequeueMessage();
+  if (NULL == sendMessage) sendMessage = fSendControlMessageQueue->DequeueMessage();
+  if (NULL == sendMessage) sendMessage = fSendMessageQueue->DequeueMessage();
+  if (NULL == sendMessage) return false;
 
   switch (sendMessage->GetType()) {
     case SINGLEREADMESSAGE :
@@ -159,6 +215,24 @@ void Clp::Send() {
     case RANGEQUERYMESSAGE :
       PreProcessSendMessage(static_cast<RangeQueryMessage *> (sendMessage));
       break;
+    case MULTIREADMESSAGE :
+      PreProcessSendMessage(static_cast<MultiReadMessage *> (sendMessage));
+      break;
+    case MULTIREADRESPONSEMESSAGE : {
+      MultiReadResponseMessage *multiReadResponseMessage = static_cast<MultiReadResponseMessage *>(sendMessage);
+      fRouter->Route(multiReadResponseMessage);
+      PreProcessSendMessage(multiReadResponseMessage);
+    }
+      break;
+    case MULTIWRITEMESSAGE :
+      PreProcessSendMessage(static_cast<MultiWriteMessage *> (sendMessage));
+      break;
+    case MULTIWRITERESPONSEMESSAGE : {
+      MultiWriteResponseMessage *multiWriteResponseMessage = static_cast<MultiWriteResponseMessage *>(sendMessage);
+      fRouter->Route(multiWriteResponseMessage);
+      PreProcessSendMessage(multiWriteResponseMessage);
+    }
+      break;
     case ROLLBACKMESSAGE : {
       RollbackMessage *rollbackMessage = static_cast<RollbackMessage *>(sendMessage);
       // TODO: Check if reroute is necessary
@@ -174,19 +248,68 @@ void Clp::Send() {
       // Skip
       break;
   }
-  fMPIInterface->Send(sendMessage);
+  fTransport->Send(sendMessage);
+  return true;
 }
 
-void Clp::Receive() {
-  // Declare received message
-  AbstractMessage *receivedMessage = NULL;
-  if (!fReceiveLoadBalancingMessageQueue->IsEmpty()) {
-    // If there's a load balancing message, deal with that first
-    receivedMessage = fReceiveLoadBalancingMessageQueue->DequeueMessage();
-  } else if (!fReceiveMessageQueue->IsEmpty()) {
-    // If there's a message, deal with it
-    receivedMessage = fReceiveMessageQueue->DequeueMessage();
+#ifdef CLP_RECEIVE_SCHEDULER
+
+AbstractMessage *Clp::HoldReceivedMessages() {
+  // Hold the shared state messages received so far, any other message is handed out straight away
+  AbstractMessage *receivedMessage;
+  while (NULL != (receivedMessage = fReceiveMessageQueue->DequeueMessage())) {
+    if (!ReceiveScheduler::IsScheduled(receivedMessage)) return receivedMessage;
+    fReceiveScheduler.Hold(static_cast<SimulationMessage *> (receivedMessage));
+  }
+  return NULL;
+}
+
+AbstractMessage *Clp::DequeueScheduledMessage() {
+  AbstractMessage *receivedMessage = HoldReceivedMessages();
+  if (NULL != receivedMessage || fReceiveScheduler.IsEmpty()) return receivedMessage;
+  // Give older messages still underway the rest of the delay to arrive
+  unsigned long waitTime = fReceiveScheduler.GetWaitTime();
+  if (waitTime > 0) {
+    Unlock();
+    usleep(waitTime);
+    Lock();
+    receivedMessage = HoldReceivedMessages();
+    if (NULL != receivedMessage) return receivedMessage;
+  }
+  // Every received message has been signalled once, so one is released whether it is due or not
+  return fReceiveScheduler.Release();
+}
+
+#endif
+
+#ifdef CLP_ANNIHILATION
+
+void Clp::DropAnnihilatedMessages() {
+  AbstractMessage *annihilatedMessage;
+  while (NULL != (annihilatedMessage = fReceiveMessageQueue->DequeueAnnihilatedMessage())) {
+    // Both were received, the GVT counters have to know
+    PreProcessReceiveMessage(static_cast<SimulationMessage *> (annihilatedMessage));
+    if (annihilatedMessage->GetType() == WRITEMESSAGE) static_cast<WriteMessage *> (annihilatedMessage)->ClearValue();
+    delete annihilatedMessage;
   }
+}
+
+#endif
+
+void Clp::Receive() {
+  // If there's a load balancing message, deal with that first
+  AbstractMessage *receivedMessage = fReceiveLoadBalancingMessageQueue->DequeueMessage();
+  // Control messages go ahead of simulation messages
+  if (NULL == receivedMessage) receivedMessage = fReceiveControlMessageQueue->DequeueMessage();
+  // If there's a message, deal with it
+#ifdef CLP_RECEIVE_SCHEDULER
+  if (NULL == receivedMessage) receivedMessage = DequeueScheduledMessage();
+#else
+  if (NULL == receivedMessage) receivedMessage = fReceiveMessageQueue->DequeueMessage();
+#endif
+#ifdef CLP_ANNIHILATION
+  DropAnnihilatedMessages();
+#endif
   // If there's no message, return
   if (NULL == receivedMessage) return;
 
@@ -198,9 +321,7 @@ void Clp::Receive() {
       singleReadMessage->IncrementNumberOfHops();
       PreProcessReceiveMessage(singleReadMessage);
       if (fRouter->Route(singleReadMessage)) {
-        ProcessMessage(singleReadMessage);
-        PostProcessMessage();
-        delete singleReadMessage;
+        ProcessSsvMessage(singleReadMessage, singleReadMessage->GetSsvId());
       } else singleReadMessage->SendToLp(this);
     }
       break;
@@ -222,9 +343,7 @@ void Clp::Receive() {
       singleReadAntiMessage->IncrementNumberOfHops();
       PreProcessReceiveMessage(singleReadAntiMessage);
       if (fRouter->Route(singleReadAntiMessage)) {
-        ProcessMessage(singleReadAntiMessage);
-        PostProcessMessage();
-        delete singleReadAntiMessage;
+        ProcessSsvMessage(singleReadAntiMessage, singleReadAntiMessage->GetSsvId());
       } else singleReadAntiMessage->SendToLp(this);
     }
       break;
@@ -233,10 +352,7 @@ void Clp::Receive() {
       writeMessage->IncrementNumberOfHops();
       PreProcessReceiveMessage(writeMessage);
       if (fRouter->Route(writeMessage)) {
-        ProcessMessage(writeMessage);
-        PostProcessMessage();
-        writeMessage->ClearValue();
-        delete writeMessage;
+        ProcessSsvMessage(writeMessage, writeMessage->GetSsvId());
       } else writeMessage->SendToLp(this);
     }
       break;
@@ -258,18 +374,61 @@ void Clp::Receive() {
       writeAntiMessage->IncrementNumberOfHops();
       PreProcessReceiveMessage(writeAntiMessage);
       if (fRouter->Route(writeAntiMessage)) {
-        ProcessMessage(writeAntiMessage);
-        PostProcessMessage();
-        delete writeAntiMessage;
+        ProcessSsvMessage(writeAntiMessage, writeAntiMessage->GetSsvId());
       } else writeAntiMessage->SendToLp(this);
     }
       break;
+    case MULTIREADMESSAGE: {
+      MultiReadMessage *multiReadMessage = static_cast<MultiReadMessage *> (receivedMessage);
+      multiReadMessage->IncrementNumberOfHops();
+      PreProcessReceiveMessage(multiReadMessage);
+      ProcessMessage(multiReadMessage);
+      PostProcessMessage();
+      delete multiReadMessage;
+    }
+      break;
+    case MULTIREADRESPONSEMESSAGE: {
+      MultiReadResponseMessage *multiReadResponseMessage =
+          static_cast<MultiReadResponseMessage *> (receivedMessage);
+      PreProcessReceiveMessage(multiReadResponseMessage);
+      if (fRouter->Route(multiReadResponseMessage)) {
+        LOG(logERROR)
+          << "Clp::Receive(" << GetRank()
+          << ")# MultiReadResponseMessage received for this CLP while CLPs don't handle response messages! "
+          << *receivedMessage;
+      } else multiReadResponseMessage->SendToLp(this);
+    }
+      break;
+    case MULTIWRITEMESSAGE: {
+      MultiWriteMessage *multiWriteMessage = static_cast<MultiWriteMessage *> (receivedMessage);
+      multiWriteMessage->IncrementNumberOfHops();
+      PreProcessReceiveMessage(multiWriteMessage);
+      ProcessMessage(multiWriteMessage);
+      PostProcessMessage();
+      delete multiWriteMessage;
+    }
+      break;
+    case MULTIWRITERESPONSEMESSAGE: {
+      MultiWriteResponseMessage *multiWriteResponseMessage =
+          static_cast<MultiWriteResponseMessage *> (receivedMessage);
+      PreProcessReceiveMessage(multiWriteResponseMessage);
+      if (fRouter->Route(multiWriteResponseMessage)) {
+        LOG(logERROR)
+          << "Clp::Receive(" << GetRank()
+          << ")# MultiWriteResponseMessage received for this CLP while CLPs don't handle response messages! "
+          << *receivedMessage;
+      } else multiWriteResponseMessage->SendToLp(this);
+    }
+      break;
 #ifdef RANGE_QUERIES
     case RANGEQUERYMESSAGE: {
       RangeQueryMessage *rangeQueryMessage =
           static_cast<RangeQueryMessage *> (receivedMessage);
       rangeQueryMessage->IncrementNumberOfHops();
       PreProcessReceiveMessage(rangeQueryMessage);
+#ifdef CLP_SHARDS
+      WaitForShards();
+#endif
       ProcessMessage(rangeQueryMessage);
       PostProcessMessage();
       delete rangeQueryMessage;
@@ -280,6 +439,9 @@ void Clp::Receive() {
           static_cast<RangeQueryAntiMessage *> (receivedMessage);
       rangeQueryAntiMessage->IncrementNumberOfHops();
       PreProcessReceiveMessage(rangeQueryAntiMessage);
+#ifdef CLP_SHARDS
+      WaitForShards();
+#endif
       ProcessMessage(rangeQueryAntiMessage);
       PostProcessMessage();
       delete rangeQueryAntiMessage;
@@ -288,6 +450,9 @@ void Clp::Receive() {
     case RANGEUPDATEMESSAGE: {
       RangeUpdateMessage *rangeUpdateMessage =
           static_cast<RangeUpdateMessage *> (receivedMessage);
+#ifdef CLP_SHARDS
+      WaitForShards();
+#endif
       ProcessMessage(rangeUpdateMessage);
       PostProcessMessage();
       delete rangeUpdateMessage;
@@ -339,6 +504,9 @@ void Clp::Receive() {
       StateMigrationMessage *stateMigrationMessage =
           static_cast<StateMigrationMessage *> (receivedMessage);
       if (fRouter->Route(stateMigrationMessage)) {
+#ifdef CLP_SHARDS
+        WaitForShards();
+#endif
         ProcessMessage(stateMigrationMessage);
         PostProcessMessage();
         delete stateMigrationMessage;
@@ -355,10 +523,51 @@ void Clp::Receive() {
 }
 
 unsigned long Clp::GetLvt() const {
+#ifdef CLP_SHARDS
+  // The messages handed to the shards have been received, but what they send is still to come
+  unsigned long lvt = ULONG_MAX;
+  for (const ClpShard *shard : fShards) lvt = min(lvt, shard->GetMinimumTimestamp());
+  return lvt;
+#else
   return ULONG_MAX;
+#endif
 }
 
-void Clp::ProcessMessage(const SingleReadMessage *pSingleReadMessage) {
+void Clp::ProcessSsvMessage(SimulationMessage *pSimulationMessage, const SsvId &pSSVID) {
+#ifdef CLP_SHARDS
+  GetShard(pSSVID)->QueueMessage(pSimulationMessage);
+#else
+  ProcessShardMessage(pSimulationMessage, fSharedState);
+#endif
+}
+
+void Clp::ProcessShardMessage(SimulationMessage *pSimulationMessage, SharedState &pSharedState) {
+  switch (pSimulationMessage->GetType()) {
+    case SINGLEREADMESSAGE:
+      ProcessMessage(static_cast<SingleReadMessage *> (pSimulationMessage), pSharedState);
+      break;
+    case SINGLEREADANTIMESSAGE:
+      ProcessMessage(static_cast<SingleReadAntiMessage *> (pSimulationMessage), pSharedState);
+      break;
+    case WRITEMESSAGE: {
+      WriteMessage *writeMessage = static_cast<WriteMessage *> (pSimulationMessage);
+      ProcessMessage(writeMessage, pSharedState);
+      writeMessage->ClearValue();
+    }
+      break;
+    case WRITEANTIMESSAGE:
+      ProcessMessage(static_cast<WriteAntiMessage *> (pSimulationMessage), pSharedState);
+      break;
+    default:
+      LOG(logERROR) << "Clp::ProcessShardMessage(" << GetRank() << ")# Not a shared state variable message: "
+                    << *pSimulationMessage;
+      exit(1);
+  }
+  PostProcessMessage();
+  delete pSimulationMessage;
+}
+
+void Clp::ProcessMessage(const SingleReadMessage *pSingleReadMessage, SharedState &pSharedState) {
   // SendReadMessageAndGetResponse the value of the SSV
   LOG(logFINEST) << "Clp::ProcessMessage(SingleReadMessage)(" << GetRank()
                  << ")# SendReadMessageAndGetResponse SSV from message: " << *pSingleReadMessage;
@@ -370,8 +579,9 @@ void Clp::ProcessMessage(const SingleReadMessage *pSingleReadMessage) {
     spdlog::critical(ss.str());
     exit(1);
   }
-  AbstractValue *value = fSharedState.Read(pSingleReadMessage->GetSsvId(),
-                                           pSingleReadMessage->GetOriginalAgent(), pSingleReadMessage->GetTimestamp());
+  std::shared_ptr<const AbstractValue> value = pSharedState.Read(pSingleReadMessage->GetSsvId(),
+                                                                 pSingleReadMessage->GetOriginalAgent(),
+                                                                 pSingleReadMessage->GetTimestamp());
   // Create and send response message
   SingleReadResponseMessage *singleReadMessageResponse =
       new SingleReadResponseMessage();
@@ -383,12 +593,12 @@ void Clp::ProcessMessage(const SingleReadMessage *pSingleReadMessage) {
   singleReadMessageResponse->SetIdentifier(pSingleReadMessage->GetIdentifier());
   singleReadMessageResponse->SetOriginalAgent(
       pSingleReadMessage->GetOriginalAgent());
-  // Value is cloned in the message
+  // Value is shared with the write period
   singleReadMessageResponse->SetValue(value);
   singleReadMessageResponse->SendToLp(this);
 #ifdef SSV_LOCALISATION
   // Update access count for state migration
-  fSharedState.UpdateAccessCount(
+  pSharedState.UpdateAccessCount(
       pSingleReadMessage->GetSsvId(),
       fRouter->GetDirectionByLpRank(
           pSingleReadMessage->GetOriginalAgent().GetRank()),
@@ -396,7 +606,7 @@ void Clp::ProcessMessage(const SingleReadMessage *pSingleReadMessage) {
 #endif
 }
 
-void Clp::ProcessMessage(const SingleReadAntiMessage *pSingleReadAntiMessage) {
+void Clp::ProcessMessage(const SingleReadAntiMessage *pSingleReadAntiMessage, SharedState &pSharedState) {
   // Check for rollbacks to before GVT
   if (fGVT > pSingleReadAntiMessage->GetTimestamp()) {
     ostringstream out;
@@ -406,26 +616,21 @@ void Clp::ProcessMessage(const SingleReadAntiMessage *pSingleReadAntiMessage) {
 
     return;
   }
-#ifdef RANGE_QUERIES
-  // Clear range updates
-  fRangeRoutingTable[HERE]->ClearRangeUpdates();
-#endif
   // Declare rollbacklist
   RollbackList rollbacklist;
   // If anti read message, rollback read
-  fSharedState.RollbackRead(pSingleReadAntiMessage->GetSsvId(),
+  pSharedState.RollbackRead(pSingleReadAntiMessage->GetSsvId(),
                             pSingleReadAntiMessage->GetOriginalAgent(),
                             pSingleReadAntiMessage->GetTimestamp());
   // Send rollbacks if necessary
   rollbacklist.SendRollbacks(this, pSingleReadAntiMessage->GetRollbackTag());
 #ifdef RANGE_QUERIES
   // Send range updates
-  SendRangeUpdates(fRangeRoutingTable[HERE]->GetRangeUpdateList(), HERE);
-  fRangeRoutingTable[HERE]->ClearRangeUpdates();
+  SendLocalRangeUpdates();
 #endif
 #ifdef SSV_LOCALISATION
   // Update access count
-  fSharedState.UpdateAccessCount(
+  pSharedState.UpdateAccessCount(
       pSingleReadAntiMessage->GetSsvId(),
       fRouter->GetDirectionByLpRank(
           pSingleReadAntiMessage->GetOriginalAgent().GetRank()),
@@ -433,17 +638,13 @@ void Clp::ProcessMessage(const SingleReadAntiMessage *pSingleReadAntiMessage) {
 #endif
 }
 
-void Clp::ProcessMessage(const WriteMessage *pWriteMessage) {
-#ifdef RANGE_QUERIES
-  // Clear range updates
-  fRangeRoutingTable[HERE]->ClearRangeUpdates();
-#endif
+void Clp::ProcessMessage(const WriteMessage *pWriteMessage, SharedState &pSharedState) {
   // Declare write status and rollbacklist variables
   WriteStatus writeStatus;
   RollbackList rollbacklist;
   // Write the value with rollback
-  fSharedState.WriteWithRollback(pWriteMessage->GetSsvId(),
-                                 pWriteMessage->GetOriginalAgent(), pWriteMessage->GetValue(),
+  pSharedState.WriteWithRollback(pWriteMessage->GetSsvId(),
+                                 pWriteMessage->GetOriginalAgent(), pWriteMessage->GetSharedValue(),
                                  pWriteMessage->GetTimestamp(), writeStatus, rollbacklist);
   // Create write message response and send it
   WriteResponseMessage *writeMessageResponse = new WriteResponseMessage();
@@ -463,45 +664,39 @@ void Clp::ProcessMessage(const WriteMessage *pWriteMessage) {
     rollbacklist.SendRollbacks(this, rollbackTag);
   }
 #ifdef RANGE_QUERIES
-  // Send range updates and clear table
-  SendRangeUpdates(fRangeRoutingTable[HERE]->GetRangeUpdateList(), HERE);
-  fRangeRoutingTable[HERE]->ClearRangeUpdates();
+  // Send range updates
+  SendLocalRangeUpdates();
 #endif
 #ifdef SSV_LOCALISATION
   // Update the access count for state migration
-  fSharedState.UpdateAccessCount(pWriteMessage->GetSsvId(),
+  pSharedState.UpdateAccessCount(pWriteMessage->GetSsvId(),
                                  fRouter->GetDirectionByLpRank(pWriteMessage->GetOriginalAgent().GetRank()),
                                  pWriteMessage->GetNumberOfHops());
 #endif
 }
 
-void Clp::ProcessMessage(const WriteAntiMessage *pWriteAntiMessage) {
+void Clp::ProcessMessage(const WriteAntiMessage *pWriteAntiMessage, SharedState &pSharedState) {
   // Check for rollbacks to before GVT
   if (fGVT > pWriteAntiMessage->GetTimestamp()) {
     LOG(logERROR) << "Clp::ProcessMessage(WriteAntiMessage)(" << GetRank() << ")# Trying to rollback to before GVT: "
                   << fGVT << ", message: " << *pWriteAntiMessage;
     return;
   }
-#ifdef RANGE_QUERIES
-  // Clear range updates
-  fRangeRoutingTable[HERE]->ClearRangeUpdates();
-#endif
   // Declare rollbacklist
   RollbackList rollbacklist;
   // If anti write message, rollback write
-  fSharedState.RollbackWrite(pWriteAntiMessage->GetSsvId(),
+  pSharedState.RollbackWrite(pWriteAntiMessage->GetSsvId(),
                              pWriteAntiMessage->GetOriginalAgent(), pWriteAntiMessage->GetTimestamp(),
                              rollbacklist);
   // Send rollbacks if necessary
   rollbacklist.SendRollbacks(this, pWriteAntiMessage->GetRollbackTag());
 #ifdef RANGE_QUERIES
   // Send range updates
-  SendRangeUpdates(fRangeRoutingTable[HERE]->GetRangeUpdateList(), HERE);
-  fRangeRoutingTable[HERE]->ClearRangeUpdates();
+  SendLocalRangeUpdates();
 #endif
 #ifdef SSV_LOCALISATION
   // Update access count
-  fSharedState.UpdateAccessCount(
+  pSharedState.UpdateAccessCount(
       pWriteAntiMessage->GetSsvId(),
       fRouter->GetDirectionByLpRank(
           pWriteAntiMessage->GetOriginalAgent().GetRank()),
@@ -509,6 +704,113 @@ void Clp::ProcessMessage(const WriteAntiMessage *pWriteAntiMessage) {
 #endif
 }
 
+void Clp::ProcessMessage(const MultiReadMessage *pMultiReadMessage) {
+  // Split the variables by the direction they are routed in
+  map<Direction, SerialisableList<SsvId> > ssvIdListByDirection;
+  for (const SsvId &ssvId : pMultiReadMessage->GetSsvIdList()) {
+    ssvIdListByDirection[fRouter->GetDirectionBySsvId(ssvId)].push_back(ssvId);
+  }
+  for (map<Direction, SerialisableList<SsvId> >::const_iterator directionIterator = ssvIdListByDirection.begin();
+       directionIterator != ssvIdListByDirection.end(); ++directionIterator) {
+    if (directionIterator->first == HERE) continue;
+    MultiReadMessage *forwardMessage = new MultiReadMessage;
+    *forwardMessage = *pMultiReadMessage;
+    forwardMessage->SetDestination(fRouter->GetLpRankByDirection(directionIterator->first));
+    forwardMessage->SetSsvIdList(directionIterator->second);
+    forwardMessage->SendToLp(this);
+  }
+  map<Direction, SerialisableList<SsvId> >::const_iterator hereIterator = ssvIdListByDirection.find(HERE);
+  if (hereIterator == ssvIdListByDirection.end()) return;
+  if (pMultiReadMessage->GetTimestamp() < fGVT) {
+    spdlog::critical("Clp::ProcessMessage(MultiReadMessage): Message timestamp less than GVT, {}<{}",
+                     pMultiReadMessage->GetTimestamp(), fGVT);
+    exit(1);
+  }
+#ifdef CLP_SHARDS
+  // The variables can be in any shard, read them while the shards are idle
+  WaitForShards();
+#endif
+  // Answer every variable held here with one response
+  MultiReadResponseMessage *multiReadResponseMessage = new MultiReadResponseMessage();
+  multiReadResponseMessage->SetOrigin(GetRank());
+  multiReadResponseMessage->SetDestination(pMultiReadMessage->GetOriginalAgent().GetRank());
+  multiReadResponseMessage->SetTimestamp(pMultiReadMessage->GetTimestamp());
+  // Mattern colour set by GVT Calculator
+  multiReadResponseMessage->SetIdentifier(pMultiReadMessage->GetIdentifier());
+  multiReadResponseMessage->SetOriginalAgent(pMultiReadMessage->GetOriginalAgent());
+  for (const SsvId &ssvId : hereIterator->second) {
+    SharedState &sharedState = GetSharedState(ssvId);
+    // Values are shared with the write periods
+    multiReadResponseMessage->AddSsvIdValue(ssvId, sharedState.Read(ssvId, pMultiReadMessage->GetOriginalAgent(),
+                                                                     pMultiReadMessage->GetTimestamp()));
+#ifdef SSV_LOCALISATION
+    // Update access count for state migration
+    sharedState.UpdateAccessCount(ssvId,
+                                  fRouter->GetDirectionByLpRank(pMultiReadMessage->GetOriginalAgent().GetRank()),
+                                  pMultiReadMessage->GetNumberOfHops());
+#endif
+  }
+  multiReadResponseMessage->SendToLp(this);
+}
+
+void Clp::ProcessMessage(const MultiWriteMessage *pMultiWriteMessage) {
+  // Split the variables by the direction they are routed in
+  map<Direction, SsvIdValueList> ssvIdValueListByDirection;
+  for (const pair<SsvId, shared_ptr<const AbstractValue> > &ssvIdValue : pMultiWriteMessage->GetSsvIdValueList()) {
+    ssvIdValueListByDirection[fRouter->GetDirectionBySsvId(ssvIdValue.first)].push_back(ssvIdValue);
+  }
+  for (map<Direction, SsvIdValueList>::const_iterator directionIterator = ssvIdValueListByDirection.begin();
+       directionIterator != ssvIdValueListByDirection.end(); ++directionIterator) {
+    if (directionIterator->first == HERE) continue;
+    MultiWriteMessage *forwardMessage = new MultiWriteMessage;
+    *forwardMessage = *pMultiWriteMessage;
+    forwardMessage->SetDestination(fRouter->GetLpRankByDirection(directionIterator->first));
+    forwardMessage->ClearSsvIdValueList();
+    for (const pair<SsvId, shared_ptr<const AbstractValue> > &ssvIdValue : directionIterator->second) {
+      forwardMessage->AddSsvIdValue(ssvIdValue.first, ssvIdValue.second);
+    }
+    forwardMessage->SendToLp(this);
+  }
+  map<Direction, SsvIdValueList>::const_iterator hereIterator = ssvIdValueListByDirection.find(HERE);
+  if (hereIterator == ssvIdValueListByDirection.end()) return;
+#ifdef CLP_SHARDS
+  // The variables can be in any shard, write them while the shards are idle
+  WaitForShards();
+#endif
+  // Answer every variable held here with one response
+  MultiWriteResponseMessage *multiWriteResponseMessage = new MultiWriteResponseMessage();
+  multiWriteResponseMessage->SetOrigin(GetRank());
+  multiWriteResponseMessage->SetDestination(pMultiWriteMessage->GetOriginalAgent().GetRank());
+  multiWriteResponseMessage->SetTimestamp(pMultiWriteMessage->GetTimestamp());
+  // Mattern colour set by GVT Calculator
+  multiWriteResponseMessage->SetIdentifier(pMultiWriteMessage->GetIdentifier());
+  multiWriteResponseMessage->SetOriginalAgent(pMultiWriteMessage->GetOriginalAgent());
+  for (const pair<SsvId, shared_ptr<const AbstractValue> > &ssvIdValue : hereIterator->second) {
+    WriteStatus writeStatus;
+    RollbackList rollbacklist;
+    SharedState &sharedState = GetSharedState(ssvIdValue.first);
+    sharedState.WriteWithRollback(ssvIdValue.first, pMultiWriteMessage->GetOriginalAgent(), ssvIdValue.second,
+                                  pMultiWriteMessage->GetTimestamp(), writeStatus, rollbacklist);
+    multiWriteResponseMessage->SetSsvIdWriteStatus(ssvIdValue.first, writeStatus);
+    // Every variable rolls back the reads it invalidated under its own tag
+    if (rollbacklist.GetSize() > 0) {
+      RollbackTag rollbackTag(ssvIdValue.first, pMultiWriteMessage->GetTimestamp(), ROLLBACK_BY_WRITE);
+      rollbacklist.SendRollbacks(this, rollbackTag);
+    }
+#ifdef SSV_LOCALISATION
+    // Update the access count for state migration
+    sharedState.UpdateAccessCount(ssvIdValue.first,
+                                  fRouter->GetDirectionByLpRank(pMultiWriteMessage->GetOriginalAgent().GetRank()),
+                                  pMultiWriteMessage->GetNumberOfHops());
+#endif
+  }
+  multiWriteResponseMessage->SendToLp(this);
+#ifdef RANGE_QUERIES
+  // Send range updates
+  SendLocalRangeUpdates();
+#endif
+}
+
 void Clp::ProcessMessage(const EndMessage *pEndMessage) {
   unsigned int parentCLP = (((int) ((GetRank() + 1) / 2)) - 1);
   unsigned int leftCLP = 2 * GetRank() + 1;
@@ -596,12 +898,43 @@ void Clp::PostProcessMessage() {
 }
 
 void Clp::Initialise() {
-  //nothing yet
+#ifdef CLP_SHARDS
+  for (ClpShard *shard : fShards) shard->Start(shard);
+#endif
 }
 
 void Clp::Finalise() {
-  fMPIInterface->StopSimulation();
-  fMPIInterface->Join();
+#ifdef CLP_SHARDS
+  // Let the shards finish what was handed to them before the transport stops
+  for (ClpShard *shard : fShards) shard->StopProcessing();
+#endif
+  fTransport->StopSimulation();
+  fTransport->Join();
+  LogReceiveQueueStatistics();
+#ifdef CLP_RECEIVE_SCHEDULER
+  spdlog::info("Clp::Finalise#Rank {0}: receive scheduler held {1} messages, released {2} ahead of earlier arrivals",
+               GetRank(), fReceiveScheduler.GetHeldCount(), fReceiveScheduler.GetReorderedCount());
+#endif
+#ifdef CLP_ANNIHILATION
+  spdlog::info("Clp::Finalise#Rank {0}: {1} messages annihilated with their anti-messages in the receive queue",
+               GetRank(), fReceiveMessageQueue->GetAnnihilatedCount());
+#endif
+#ifdef CLP_SHARDS
+  for (unsigned int shard = 0; shard < fShards.size(); ++shard) {
+    spdlog::info("Clp::Finalise#Rank {0}: shard {1} processed {2} messages", GetRank(), shard,
+                 fShards[shard]->GetProcessedCount());
+  }
+#endif
+#ifdef LAZY_CANCELLATION
+#ifdef CLP_SHARDS
+  unsigned long keptReadCount = 0;
+  for (ClpShard *shard : fShards) keptReadCount += shard->GetSharedState().GetKeptReadCount();
+#else
+  unsigned long keptReadCount = fSharedState.GetKeptReadCount();
+#endif
+  spdlog::info("Clp::Finalise#Rank {0}: {1} read rollbacks suppressed as the value read stayed the same", GetRank(),
+               keptReadCount);
+#endif
 }
 
 #ifdef SSV_LOCALISATION
@@ -620,7 +953,8 @@ void Clp::ProcessMessage(const StateMigrationMessage *pStateMigrationMessage) {
     fRouter->SetSsvIdDirection(stateVariableMapIterator->first, (Direction) HERE);
     // Insert the state variable
     RollbackList rollbackList;
-    fSharedState.Insert(stateVariableMapIterator->first, stateVariableMapIterator->second, rollbackList);
+    GetSharedState(stateVariableMapIterator->first).Insert(stateVariableMapIterator->first,
+                                                           stateVariableMapIterator->second, rollbackList);
     // Send rollbacks if necessary
     if (rollbackList.GetSize() > 0) {
       RollbackTag rbTag(stateVariableMapIterator->first, ULONG_MAX, ROLLBACK_BY_SM);
@@ -662,14 +996,15 @@ void Clp::MigrateStateVariables(
     list<SsvId>::const_iterator ssvIdListIterator = (migrateSSVMapIterator->second).begin();
     while (ssvIdListIterator != (migrateSSVMapIterator->second).end()) {
       // Set the state variable in the load balancing load message
-      loadBalancingLoadMessage->SetStateVariableMap(*ssvIdListIterator, fSharedState.GetCopy(*ssvIdListIterator));
+      loadBalancingLoadMessage->SetStateVariableMap(*ssvIdListIterator,
+                                                    GetSharedState(*ssvIdListIterator).GetCopy(*ssvIdListIterator));
       // Update the direction for this SSV
       fRouter->SetSsvIdDirection(*ssvIdListIterator, migrateSSVMapIterator->first);
       // Remove all write periods
       RollbackList rollbackList;
-      fSharedState.RemoveWritePeriodList(*ssvIdListIterator, rollbackList);
+      GetSharedState(*ssvIdListIterator).RemoveWritePeriodList(*ssvIdListIterator, rollbackList);
       // Delete the SSV from the shared state
-      fSharedState.Delete(*ssvIdListIterator);
+      GetSharedState(*ssvIdListIterator).Delete(*ssvIdListIterator);
       // Send rollbacks if necessary
       if (rollbackList.GetSize() > 0) {
         RollbackTag rbTag(*ssvIdListIterator, ULONG_MAX, ROLLBACK_BY_SM);
@@ -769,7 +1104,7 @@ void Clp::ProcessMessage(const RangeQueryMessage *pRangeQueryMessage) {
             blockStatus.insert(make_pair(*portListIterator, NOT_BLOCKED));
             if (*portListIterator == HERE) {
               newRangeQueryMessage->SetSsvValueList(
-                  fSharedState.RangeRead(
+                  RangeRead(
                       newRangeQueryMessage->GetRange(),
                       fRouter->GetDirectionByLpRank(
                           newRangeQueryMessage->GetOriginalAgent().GetRank()),
@@ -987,6 +1322,34 @@ void Clp::SendRangeUpdates(const list<RangeUpdates> &pRangeUpdateList,
   }
 }
 
+void Clp::SendLocalRangeUpdates() {
+#ifdef CLP_SHARDS
+  // The shards add their updates while holding the mutex, whichever sends them sends them in that order
+  fShardMutex.Lock();
+#endif
+  SendRangeUpdates(fRangeRoutingTable[HERE]->GetRangeUpdateList(), HERE);
+  fRangeRoutingTable[HERE]->ClearRangeUpdates();
+#ifdef CLP_SHARDS
+  fShardMutex.Unlock();
+#endif
+}
+
+SerialisableMap<SsvId, Value<Point> > Clp::RangeRead(const Range &pRange, Direction pDirection,
+                                                     unsigned long pHops, unsigned long pTime) {
+#ifdef CLP_SHARDS
+  // Every shard holds part of the variables, merge the points they find
+  SerialisableMap<SsvId, Value<Point> > pointMap;
+  for (ClpShard *shard : fShards) {
+    SerialisableMap<SsvId, Value<Point> > shardPointMap = shard->GetSharedState().RangeRead(pRange, pDirection,
+                                                                                            pHops, pTime);
+    pointMap.insert(shardPointMap.begin(), shardPointMap.end());
+  }
+  return pointMap;
+#else
+  return fSharedState.RangeRead(pRange, pDirection, pHops, pTime);
+#endif
+}
+
 void Clp::InitialisePortRanges(const Initialisor *pInitialisor) {
   Range *PortRange[DIRECTION_SIZE];
   for (int i = 0; i < DIRECTION_SIZE; ++i) {
@@ -1033,7 +1396,12 @@ void Clp::InitialisePortRanges(const Initialisor *pInitialisor) {
   clpRangeMap.clear();
 
   // Verify the local port range information again for correctness.
+#ifdef CLP_SHARDS
+  // The shards share the bounds of their points, each has the range of all of them
+  Range *newRange = fShards.front()->GetSharedState().RecalculateRange(fStartTime);
+#else
   Range *newRange = fSharedState.RecalculateRange(fStartTime);
+#endif
   Range *storedRange = fRangeRoutingTable[HERE]->GetRangeCopy(fStartTime);
   // If the recalculated range and the stored range aren't NULL and are not the same, update everything
   if ((newRange && storedRange) && (*newRange != *storedRange)) {
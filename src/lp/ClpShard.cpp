@@ -0,0 +1,84 @@
+#include <climits>
+#include "ClpShard.h"
+#include "Clp.h"
+
+using namespace std;
+using namespace pdesmas;
+
+ClpShard::ClpShard(Clp *pClp) :
+    fClp(pClp), fIsProcessing(false), fProcessingTimestamp(ULONG_MAX), fIsRunning(true), fProcessedCount(0),
+    fMutex(NORMAL) {
+}
+
+SharedState &ClpShard::GetSharedState() {
+  return fSharedState;
+}
+
+void ClpShard::QueueMessage(SimulationMessage *pSimulationMessage) {
+  fMutex.Lock();
+  fMessageQueue.push_back(pSimulationMessage);
+  fMutex.Unlock();
+  // One signal for every message
+  Signal();
+}
+
+void ClpShard::WaitUntilIdle() {
+  fMutex.Lock();
+  while (fIsProcessing || !fMessageQueue.empty()) {
+    fMutex.Wait();
+  }
+  fMutex.Unlock();
+}
+
+unsigned long ClpShard::GetMinimumTimestamp() const {
+  fMutex.Lock();
+  unsigned long minimumTimestamp = fIsProcessing ? fProcessingTimestamp : ULONG_MAX;
+  for (const SimulationMessage *simulationMessage : fMessageQueue) {
+    minimumTimestamp = min(minimumTimestamp, simulationMessage->GetTimestamp());
+  }
+  fMutex.Unlock();
+  return minimumTimestamp;
+}
+
+unsigned long ClpShard::GetProcessedCount() const {
+  fMutex.Lock();
+  unsigned long processedCount = fProcessedCount;
+  fMutex.Unlock();
+  return processedCount;
+}
+
+void ClpShard::StopProcessing() {
+  fMutex.Lock();
+  fIsRunning = false;
+  fMutex.Unlock();
+  Signal();
+  Join();
+}
+
+void *ClpShard::MyThread(void *pArgument) {
+  while (true) {
+    Wait();
+    fMutex.Lock();
+    if (fMessageQueue.empty()) {
+      // Only the stop signal comes without a message
+      bool isRunning = fIsRunning;
+      fMutex.Unlock();
+      if (isRunning) continue;
+      break;
+    }
+    SimulationMessage *simulationMessage = fMessageQueue.front();
+    fMessageQueue.pop_front();
+    fIsProcessing = true;
+    fProcessingTimestamp = simulationMessage->GetTimestamp();
+    fMutex.Unlock();
+    // Processing deletes the message
+    fClp->ProcessShardMessage(simulationMessage, fSharedState);
+    fMutex.Lock();
+    fIsProcessing = false;
+    fProcessingTimestamp = ULONG_MAX;
+    ++fProcessedCount;
+    if (fMessageQueue.empty()) fMutex.Signal();
+    fMutex.Unlock();
+  }
+  pthread_exit(0);
+}
@@ -2,6 +2,7 @@
 #include "Lp.h"
 #include "Log.h"
 #include "GvtRequestMessage.h"
+#include "Backoff.h"
 #include <spdlog/spdlog.h>
 #include <algorithm>
 
@@ -55,7 +56,7 @@ void GvtCalculator::ProcessMessage(const GvtValueMessage *pGvtValueMessage) {
     spdlog::info("GvtCalculator::ProcessGvt(rank={0})# GVT value ({1}) is greater or equal to end time ({2}), barrier!",
                  fLp->GetRank(), pGvtValueMessage->GetGVT(), fLp->GetEndTime());
 
-    MPI_Barrier(MPI_COMM_WORLD);
+    fLp->fTransport->Barrier();
   }
   // Set GVT at the LP
   fLp->SetGvt(pGvtValueMessage->GetGVT());
@@ -198,7 +199,7 @@ void GvtCalculator::ProcessSecondCutGvtControl(
   // Process the still outstanding messages
   while (outstanding + GetWhiteTransientMessageCounter(fLp->GetRank()) > 0) {
     fLp->Unlock();
-    fLp->fMPIInterface->ReceiveWait();
+    fLp->fTransport->ReceiveWait();
     fLp->Lock();
     fLp->Receive();
   }
@@ -276,15 +277,14 @@ void GvtCalculator::SendAndSetGvt(const GvtControlMessage *pGvtControlMessage) {
   // If GVT has reached end time
   if (gvt >= fLp->GetEndTime()) {
     // Yield all control messages
+    Backoff backoff;
     while (!fLp->fSendControlMessageQueue->IsEmpty()) {
       fLp->Unlock();
-      sched_yield();
+      backoff.Idle();
       fLp->Lock();
     }
     // And barrier
-    fLp->fMPIInterface->LockMpi();
-    MPI_Barrier(MPI_COMM_WORLD);
-    fLp->fMPIInterface->UnlockMpi();
+    fLp->fTransport->Barrier();
   }
   // Set GVT at the Lp
   fLp->SetGvt(gvt);
@@ -1,5 +1,4 @@
 #include <iostream>
-#include <mpi.h>
 #include <assert.h>
 #include "Lp.h"
 #include "Log.h"
@@ -10,7 +9,8 @@ using namespace std;
 Lp::Lp() {
   fProcessMutex = Mutex();
   fReceiveMessageQueue = new MessageQueue();
-  fSendMessageQueue = new MessageQueue();
+  fReceiveControlMessageQueue = new MessageQueue();
+  fSendMessageQueue = new MessageQueue(true);
   fSendControlMessageQueue = new MessageQueue();
 
   fReceiveLoadBalancingMessageQueue = new MessageQueue();
@@ -19,6 +19,7 @@ Lp::Lp() {
 
 Lp::~Lp() {
   delete fReceiveMessageQueue;
+  delete fReceiveControlMessageQueue;
   delete fSendMessageQueue;
   delete fSendControlMessageQueue;
   delete fReceiveLoadBalancingMessageQueue;
@@ -44,15 +45,28 @@ void Lp::PreProcessReceiveMessage(const SimulationMessage *pSimulationMessage) {
   }
 }
 
+void Lp::LogReceiveQueueStatistics() const {
+  const MessageQueue* receiveQueues[LANE_SIZE];
+  receiveQueues[LOAD_BALANCING_LANE] = fReceiveLoadBalancingMessageQueue;
+  receiveQueues[CONTROL_LANE] = fReceiveControlMessageQueue;
+  receiveQueues[SIMULATION_LANE] = fReceiveMessageQueue;
+  for (int lane = 0; lane < LANE_SIZE; ++lane) {
+    const MessageQueue* queue = receiveQueues[lane];
+    spdlog::info("Lp::LogReceiveQueueStatistics#Rank {0}: {1} lane received {2}, mean depth {3:.2f}, peak depth {4}",
+                 GetRank(), GetLaneName((MessageLane) lane), queue->GetQueuedCount(), queue->GetMeanDepth(),
+                 queue->GetPeakSize());
+  }
+}
+
 void Lp::Run() {
   //spdlog::debug("Lp run, rank {0}", this->GetRank());
-  MPI_Barrier(MPI_COMM_WORLD);
+  fTransport->Barrier();
   Initialise();
 
   while (!TerminationCondition()) {
     //spdlog::debug(">>> Lp rank {0}, GVT: {1}, entering block", this->GetRank(), this->GetGvt());
 
-    fMPIInterface->ReceiveWait();
+    fTransport->ReceiveWait();
     //spdlog::debug("<<< Lp rank {0}, Signal", this->GetRank());
 
     /*
@@ -82,7 +96,7 @@ void Lp::Unlock() {
 }
 
 void Lp::SignalSend() {
-  fMPIInterface->SendSignal();
+  fTransport->SendSignal();
 }
 
 bool Lp::AllEndMessagesReceived() const {
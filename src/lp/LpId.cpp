@@ -68,3 +68,11 @@ void LpId::Deserialise(istream& istr) {
   istr >> fRank;
   istr.ignore(numeric_limits<streamsize>::max(), DELIM_RIGHT);
 }
+
+void LpId::Pack(WireWriter& pWriter) const {
+  pWriter << fIdentifier << fRank;
+}
+
+void LpId::Unpack(WireReader& pReader) {
+  pReader >> fIdentifier >> fRank;
+}
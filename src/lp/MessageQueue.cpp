@@ -1,85 +1,273 @@
-#include "MessageQueue.h" 
-#include "SingleReadResponseMessage.h"
+#include <sched.h>
+#include "MessageQueue.h"
+#include "SingleReadMessage.h"
 #include "WriteMessage.h"
 #include "RangeQueryMessage.h"
+#include "SingleReadAntiMessage.h"
+#include "WriteAntiMessage.h"
+#include "RangeQueryAntiMessage.h"
 
 using namespace std;
 using namespace pdesmas;
 
-MessageQueue::MessageQueue() {
+MessageQueue::MessageQueue(bool pIsIndexed) :
+    fFrontSequence(0), fMessageCount(0), fIsIndexed(pIsIndexed), fIsAnnihilating(false), fAnnihilatedCount(0),
+    fQueuedCount(0), fDepthSum(0), fPeakSize(0) {
   fMutex = Mutex(NORMAL);
+  // The inbox always holds the node taken last, start with an empty one
+  fInboxHead = new Node();
+  fInboxHead->fNext.store(NULL, memory_order_relaxed);
+  fInboxTail.store(fInboxHead, memory_order_relaxed);
 }
 
 MessageQueue::~MessageQueue() {
-  // Do nothing
+  // Messages still queued are not owned by the queue, only free the nodes
+  while (fInboxHead != NULL) {
+    Node* next = fInboxHead->fNext.load(memory_order_relaxed);
+    delete fInboxHead;
+    fInboxHead = next;
+  }
+}
+
+bool MessageQueue::GetIndexKey(const AbstractMessage* pMessage, LpId& pOriginalAgent, unsigned long& pTimestamp) {
+  switch (pMessage->GetType()) {
+    case SINGLEREADMESSAGE :
+    case WRITEMESSAGE :
+    case RANGEQUERYMESSAGE :
+    case MULTIREADMESSAGE :
+    case MULTIWRITEMESSAGE : {
+      const SharedStateMessage* sharedStateMessage = static_cast<const SharedStateMessage*>(pMessage);
+      pOriginalAgent = sharedStateMessage->GetOriginalAgent();
+      pTimestamp = sharedStateMessage->GetTimestamp();
+    }
+      return true;
+    default :
+      return false;
+  }
+}
+
+bool MessageQueue::IsAnnihilatedBy(const AbstractMessage* pMessage, const AbstractMessage* pAntiMessage) {
+  // Only pairs that came over the same link, a range query reply has the identifier of the query too
+  if (pMessage->GetOrigin() != pAntiMessage->GetOrigin()) return false;
+  switch (pAntiMessage->GetType()) {
+    case SINGLEREADANTIMESSAGE :
+      return pMessage->GetType() == SINGLEREADMESSAGE
+          && static_cast<const SingleReadMessage*>(pMessage)->GetSsvId()
+              == static_cast<const SingleReadAntiMessage*>(pAntiMessage)->GetSsvId();
+    case WRITEANTIMESSAGE :
+      return pMessage->GetType() == WRITEMESSAGE
+          && static_cast<const WriteMessage*>(pMessage)->GetSsvId()
+              == static_cast<const WriteAntiMessage*>(pAntiMessage)->GetSsvId();
+    case RANGEQUERYANTIMESSAGE :
+      return pMessage->GetType() == RANGEQUERYMESSAGE
+          && static_cast<const RangeQueryMessage*>(pMessage)->GetIdentifier()
+              == static_cast<const RangeQueryAntiMessage*>(pAntiMessage)->GetIdentifier();
+    default :
+      return false;
+  }
+}
+
+bool MessageQueue::Annihilate(AbstractMessage* pAntiMessage) {
+  switch (pAntiMessage->GetType()) {
+    case SINGLEREADANTIMESSAGE :
+    case WRITEANTIMESSAGE :
+    case RANGEQUERYANTIMESSAGE :
+      break;
+    default :
+      return false;
+  }
+  const AntiMessage* antiMessage = static_cast<const AntiMessage*>(pAntiMessage);
+  const LpId& originalAgent = antiMessage->GetOriginalAgent();
+  map<pair<unsigned int, unsigned long>, multimap<unsigned long, unsigned long> >::iterator agentIterator =
+      fAgentIndex.find(make_pair(originalAgent.GetRank(), originalAgent.GetId()));
+  if (agentIterator == fAgentIndex.end()) return false;
+  // The positive message has the timestamp of its anti-message
+  pair<multimap<unsigned long, unsigned long>::iterator, multimap<unsigned long, unsigned long>::iterator> range =
+      agentIterator->second.equal_range(antiMessage->GetTimestamp());
+  for (multimap<unsigned long, unsigned long>::iterator iter = range.first; iter != range.second; ++iter) {
+    deque<AbstractMessage*>::iterator entry = fMessageQueue.begin() + (iter->second - fFrontSequence);
+    if (IsAnnihilatedBy(*entry, pAntiMessage)) {
+      fAnnihilatedMessages.push_back(*entry);
+      fAnnihilatedMessages.push_back(pAntiMessage);
+      *entry = NULL;
+      --fMessageCount;
+      agentIterator->second.erase(iter);
+      ++fAnnihilatedCount;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MessageQueue::IsCancelled(const AbstractMessage* pMessage, const LpId& pOriginalAlp, unsigned long pTime) {
+  LpId originalAgent;
+  unsigned long timestamp;
+  if (!GetIndexKey(pMessage, originalAgent, timestamp) || originalAgent != pOriginalAlp) return false;
+  // Note, the write messages have one plus the LVT (pTime) at a timestep, so no equals here!
+  if (pMessage->GetType() == WRITEMESSAGE || pMessage->GetType() == MULTIWRITEMESSAGE) return timestamp > pTime;
+  return timestamp >= pTime;
+}
+
+void MessageQueue::AddToIndex(const AbstractMessage* pMessage, unsigned long pSequence) {
+  LpId originalAgent;
+  unsigned long timestamp;
+  if (!fIsIndexed || !GetIndexKey(pMessage, originalAgent, timestamp)) return;
+  fAgentIndex[make_pair(originalAgent.GetRank(), originalAgent.GetId())].insert(
+      multimap<unsigned long, unsigned long>::value_type(timestamp, pSequence));
+}
+
+void MessageQueue::RemoveFromIndex(const AbstractMessage* pMessage, unsigned long pSequence) {
+  LpId originalAgent;
+  unsigned long timestamp;
+  if (!fIsIndexed || !GetIndexKey(pMessage, originalAgent, timestamp)) return;
+  multimap<unsigned long, unsigned long>& timestampIndex =
+      fAgentIndex[make_pair(originalAgent.GetRank(), originalAgent.GetId())];
+  pair<multimap<unsigned long, unsigned long>::iterator, multimap<unsigned long, unsigned long>::iterator> range =
+      timestampIndex.equal_range(timestamp);
+  for (multimap<unsigned long, unsigned long>::iterator iter = range.first; iter != range.second; ++iter) {
+    if (iter->second == pSequence) {
+      timestampIndex.erase(iter);
+      return;
+    }
+  }
+}
+
+void MessageQueue::RemoveEntry(deque<AbstractMessage*>::iterator pEntry) {
+  if ((*pEntry)->GetType() == WRITEMESSAGE) static_cast<WriteMessage*>(*pEntry)->ClearValue();
+  delete *pEntry;
+  *pEntry = NULL;
+  --fMessageCount;
+}
+
+void MessageQueue::TakeInbox() {
+  // Take every message pushed so far. A producer that already claimed the tail but has not
+  // linked its node yet is waited for, its message may have been signalled behind a later one.
+  Node* tail = fInboxTail.load(memory_order_acquire);
+  while (fInboxHead != tail) {
+    Node* next = fInboxHead->fNext.load(memory_order_acquire);
+    if (next == NULL) {
+      sched_yield();
+      continue;
+    }
+    ++fQueuedCount;
+    if (!fIsAnnihilating || !Annihilate(next->fMessage)) {
+      AddToIndex(next->fMessage, fFrontSequence + fMessageQueue.size());
+      fMessageQueue.push_back(next->fMessage);
+      ++fMessageCount;
+    }
+    fDepthSum += fMessageCount;
+    if (fMessageCount > fPeakSize) fPeakSize = fMessageCount;
+    delete fInboxHead;
+    fInboxHead = next;
+  }
 }
 
 bool MessageQueue::IsEmpty() const {
   fMutex.Lock();
-  bool isEmpty = (fMessageQueue.size() == 0);
+  bool isEmpty = (fMessageCount == 0) && fInboxTail.load(memory_order_acquire) == fInboxHead;
   fMutex.Unlock();
   return isEmpty;
 }
 
 void MessageQueue::QueueMessage(AbstractMessage* item) {
+  Node* node = new Node();
+  node->fNext.store(NULL, memory_order_relaxed);
+  node->fMessage = item;
+  // Claim the tail, then link the previous tail to the new node
+  Node* previous = fInboxTail.exchange(node, memory_order_acq_rel);
+  previous->fNext.store(node, memory_order_release);
+}
+
+AbstractMessage* MessageQueue::DequeueMessage() {
   fMutex.Lock();
-  fMessageQueue.push_back(item);
+  // An annihilating queue takes every arrival, so anti-messages meet the messages still queued
+  if (fIsAnnihilating || fMessageCount == 0) TakeInbox();
+  AbstractMessage* result = NULL;
+  // Skip the entries of removed messages
+  while (result == NULL && !fMessageQueue.empty()) {
+    result = fMessageQueue.front();
+    fMessageQueue.pop_front();
+    if (result != NULL) {
+      RemoveFromIndex(result, fFrontSequence);
+      --fMessageCount;
+    }
+    ++fFrontSequence;
+  }
   fMutex.Unlock();
+  return result;
 }
 
-AbstractMessage* MessageQueue::DequeueMessage() {
+AbstractMessage* MessageQueue::DequeueAnnihilatedMessage() {
   fMutex.Lock();
-  AbstractMessage* result = fMessageQueue.front();
-  fMessageQueue.pop_front();
+  AbstractMessage* result = NULL;
+  if (!fAnnihilatedMessages.empty()) {
+    result = fAnnihilatedMessages.front();
+    fAnnihilatedMessages.pop_front();
+  }
   fMutex.Unlock();
   return result;
 }
 
+void MessageQueue::EnableAnnihilation() {
+  fIsIndexed = true;
+  fIsAnnihilating = true;
+}
+
 void MessageQueue::RemoveMessages(const LpId& pOriginalAlp, unsigned long pTime) {
-  // Lock the queue
+  // Lock the consumer side and take the messages that arrived so far
   fMutex.Lock();
-  // Initialise result
-  // If no messages in queue, do nothing
-  if (fMessageQueue.size() > 0) {
-    // Walk over all messages
-    for (deque<AbstractMessage*>::iterator iter = fMessageQueue.begin(); iter != fMessageQueue.end();) {
-      switch((*iter)->GetType()) {
-        case SINGLEREADMESSAGE : {
-          SingleReadMessage* singleReadMessage = static_cast<SingleReadMessage*>(*iter);
-          if (singleReadMessage->GetOriginalAgent() == pOriginalAlp && singleReadMessage->GetTimestamp() >= pTime) {
-            delete *iter;
-            iter = fMessageQueue.erase(iter);
-            continue;
-          }
-        }
-          break;
-        case WRITEMESSAGE : {
-          WriteMessage* writeMessage = static_cast<WriteMessage*>(*iter);
-          // Note, the write messages have one plus the LVT (pTime) at a timestep, so no equals here!
-          if (writeMessage->GetOriginalAgent() == pOriginalAlp && writeMessage->GetTimestamp() > pTime) {
-            writeMessage->ClearValue();
-            delete *iter;
-            iter = fMessageQueue.erase(iter);
-            continue;
-          }
-        }
-          break;
-        case RANGEQUERYMESSAGE : {
-          RangeQueryMessage* rangeQueryMessage = static_cast<RangeQueryMessage*>(*iter);
-          if (rangeQueryMessage->GetOriginalAgent() == pOriginalAlp && rangeQueryMessage->GetTimestamp() >= pTime) {
-            delete *iter;
-            iter = fMessageQueue.erase(iter);
-            continue;
-          }
-        }
-          break;
-        default :
-          // Skip
-          break;
+  TakeInbox();
+  if (fIsIndexed) {
+    // Only visit the messages of the agent from the time on
+    map<pair<unsigned int, unsigned long>, multimap<unsigned long, unsigned long> >::iterator agentIterator =
+        fAgentIndex.find(make_pair(pOriginalAlp.GetRank(), pOriginalAlp.GetId()));
+    if (agentIterator != fAgentIndex.end()) {
+      multimap<unsigned long, unsigned long>& timestampIndex = agentIterator->second;
+      for (multimap<unsigned long, unsigned long>::iterator iter = timestampIndex.lower_bound(pTime);
+           iter != timestampIndex.end();) {
+        deque<AbstractMessage*>::iterator entry = fMessageQueue.begin() + (iter->second - fFrontSequence);
+        if (IsCancelled(*entry, pOriginalAlp, pTime)) {
+          RemoveEntry(entry);
+          timestampIndex.erase(iter++);
+        } else ++iter;
       }
-      iter++;
     }
+  } else {
+    // Walk over all messages
+    for (deque<AbstractMessage*>::iterator iter = fMessageQueue.begin(); iter != fMessageQueue.end(); ++iter) {
+      if (*iter != NULL && IsCancelled(*iter, pOriginalAlp, pTime)) RemoveEntry(iter);
+    }
+  }
+  // Drop the empty entries from the front
+  while (!fMessageQueue.empty() && fMessageQueue.front() == NULL) {
+    fMessageQueue.pop_front();
+    ++fFrontSequence;
   }
   // Unlock the queue
   fMutex.Unlock();
 }
+
+unsigned long MessageQueue::GetAnnihilatedCount() const {
+  return fAnnihilatedCount;
+}
+
+unsigned long MessageQueue::GetQueuedCount() const {
+  fMutex.Lock();
+  unsigned long queuedCount = fQueuedCount;
+  fMutex.Unlock();
+  return queuedCount;
+}
+
+unsigned long MessageQueue::GetPeakSize() const {
+  fMutex.Lock();
+  unsigned long peakSize = fPeakSize;
+  fMutex.Unlock();
+  return peakSize;
+}
+
+double MessageQueue::GetMeanDepth() const {
+  fMutex.Lock();
+  double meanDepth = (fQueuedCount == 0) ? 0 : (double) fDepthSum / fQueuedCount;
+  fMutex.Unlock();
+  return meanDepth;
+}
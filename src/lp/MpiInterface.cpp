@@ -5,6 +5,7 @@
 #include "ObjectMgr.h"
 #include "ReceiveThread.h"
 #include "SendThread.h"
+#include "SharedMemoryTransport.h"
 #include "Log.h"
 
 using namespace pdesmas;
@@ -16,6 +17,19 @@ MpiInterface::MpiInterface() {
 
 MpiInterface::MpiInterface(Lp* pLp, void* pArguments) {
   fMutex = Mutex();
+  int providedThreadSupport;
+  MPI_Query_thread(&providedThreadSupport);
+  fIsThreadMultiple = (providedThreadSupport == MPI_THREAD_MULTIPLE);
+  // Keep message traffic apart from the collectives on MPI_COMM_WORLD
+  MPI_Comm_dup(MPI_COMM_WORLD, &fCommunicator);
+  fSharedMemoryTransport = nullptr;
+#ifdef SHARED_MEMORY_TRANSPORT
+  fSharedMemoryTransport = new SharedMemoryTransport(fCommunicator);
+  if (!fSharedMemoryTransport->HasLocalRanks()) {
+    delete fSharedMemoryTransport;
+    fSharedMemoryTransport = nullptr;
+  }
+#endif
 
   sendThread = new SendThread(pLp, this);
   receiveThread = new ReceiveThread(pLp, this);
@@ -29,13 +43,37 @@ MpiInterface::~MpiInterface() {
 }
 
 int MpiInterface::LockMpi(){
+  if (fIsThreadMultiple) return 0;
   return fMutex.Lock();
 }
 
 int MpiInterface::UnlockMpi(){
+  if (fIsThreadMultiple) return 0;
   return fMutex.Unlock();
 }
 
+int MpiInterface::LockSend(){
+  if (fIsThreadMultiple) return fSendMutex.Lock();
+  return fMutex.Lock();
+}
+
+int MpiInterface::UnlockSend(){
+  if (fIsThreadMultiple) return fSendMutex.Unlock();
+  return fMutex.Unlock();
+}
+
+bool MpiInterface::IsThreadMultiple() const {
+  return fIsThreadMultiple;
+}
+
+MPI_Comm MpiInterface::GetCommunicator() const {
+  return fCommunicator;
+}
+
+SharedMemoryTransport* MpiInterface::GetSharedMemoryTransport() const {
+  return fSharedMemoryTransport;
+}
+
 
 void MpiInterface::Signal() {
   receiveThread->Signal();
@@ -46,6 +84,20 @@ void MpiInterface::Send(AbstractMessage* sendMsg){
   sendThread->Send(sendMsg);
 }
 
+void MpiInterface::FlushSends(){
+  sendThread->FlushAll();
+}
+
+void MpiInterface::Barrier(){
+  // Including the envelopes the send thread still holds back for coalescing
+  LockSend();
+  FlushSends();
+  UnlockSend();
+  LockMpi();
+  MPI_Barrier(MPI_COMM_WORLD);
+  UnlockMpi();
+}
+
 void MpiInterface::StopSimulation(){
   receiveThread->StopSimulation();
   sendThread->StopSimulation();
@@ -70,6 +122,14 @@ void MpiInterface::SendWait() {
   sendSemaphore.Wait();
 }
 
+bool MpiInterface::SendWait(unsigned long pTimeout) {
+  return sendSemaphore.WaitFor(pTimeout);
+}
+
+bool MpiInterface::SendTryWait() {
+  return sendSemaphore.TryWait();
+}
+
 void MpiInterface::ReceiveSignal() {
   recvSemaphore.Signal();
 }
@@ -0,0 +1,74 @@
+#include "ReceiveScheduler.h"
+#include "Helper.h"
+
+using namespace std;
+using namespace pdesmas;
+
+bool ReceiveScheduler::IsLater::operator()(const HeldMessage& pLeft, const HeldMessage& pRight) const {
+  if (pLeft.fTimestamp != pRight.fTimestamp) return pLeft.fTimestamp > pRight.fTimestamp;
+  return pLeft.fSequence > pRight.fSequence;
+}
+
+ReceiveScheduler::ReceiveScheduler() :
+    fSequence(0), fReorderedCount(0) {
+}
+
+ReceiveScheduler::~ReceiveScheduler() {
+  // Messages still held are not owned by the scheduler
+}
+
+bool ReceiveScheduler::IsScheduled(const AbstractMessage* pMessage) {
+  switch (pMessage->GetType()) {
+    case SINGLEREADMESSAGE :
+    case SINGLEREADANTIMESSAGE :
+    case WRITEMESSAGE :
+    case WRITEANTIMESSAGE :
+    case RANGEQUERYMESSAGE :
+    case RANGEQUERYANTIMESSAGE :
+    case MULTIREADMESSAGE :
+    case MULTIWRITEMESSAGE :
+      return true;
+    default :
+      // Responses, rollbacks and anything else pass straight through
+      return false;
+  }
+}
+
+void ReceiveScheduler::Hold(SimulationMessage* pMessage) {
+  HeldMessage heldMessage;
+  heldMessage.fTimestamp = pMessage->GetTimestamp();
+  heldMessage.fSequence = fSequence++;
+  heldMessage.fArrivalTime = Helper::GetTimeInUS();
+  heldMessage.fMessage = pMessage;
+  fHeldMessages.push(heldMessage);
+  fHeldSequences.insert(heldMessage.fSequence);
+}
+
+bool ReceiveScheduler::IsEmpty() const {
+  return fHeldMessages.empty();
+}
+
+unsigned long ReceiveScheduler::GetWaitTime() const {
+  if (fHeldMessages.empty()) return 0;
+  unsigned long waitedTime = Helper::GetTimeInUS() - fHeldMessages.top().fArrivalTime;
+  return (waitedTime >= CLP_RECEIVE_SCHEDULER_DELAY) ? 0 : CLP_RECEIVE_SCHEDULER_DELAY - waitedTime;
+}
+
+SimulationMessage* ReceiveScheduler::Release() {
+  if (fHeldMessages.empty()) return NULL;
+  const HeldMessage& heldMessage = fHeldMessages.top();
+  SimulationMessage* message = heldMessage.fMessage;
+  // An earlier arrival still held means this one overtook it
+  if (*fHeldSequences.begin() != heldMessage.fSequence) ++fReorderedCount;
+  fHeldSequences.erase(heldMessage.fSequence);
+  fHeldMessages.pop();
+  return message;
+}
+
+unsigned long ReceiveScheduler::GetHeldCount() const {
+  return fSequence;
+}
+
+unsigned long ReceiveScheduler::GetReorderedCount() const {
+  return fReorderedCount;
+}
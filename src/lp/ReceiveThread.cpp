@@ -1,87 +1,200 @@
 #include "MpiInterface.h"
 #include "ReceiveThread.h"
 #include <sstream>
+#include <cstring>
 #include <mpi.h>
 #include "Lp.h"
 #include "ObjectMgr.h"
+#include "SharedMemoryTransport.h"
 #include <spdlog/spdlog.h>
 
 using namespace std;
 
 ReceiveThread::ReceiveThread(Lp *pLp, MpiInterface *pMPIInterface)
     : fLp(pLp), fMPIInterface(pMPIInterface), fIsSimulationRunning(true) {
+  for (int lane = 0; lane < LANE_SIZE; ++lane) {
+    fRingHeads[lane] = lane * RECEIVE_RING_SIZE;
+  }
+  for (int slot = 0; slot < LANE_SIZE * RECEIVE_RING_SIZE; ++slot) {
+    fRequests[slot] = MPI_REQUEST_NULL;
+    fSlotBuffers[slot] = new char[RECEIVE_SLOT_SIZE];
+  }
   Start(this);
 }
 
 ReceiveThread::~ReceiveThread() {
   Stop();
+  for (int slot = 0; slot < LANE_SIZE * RECEIVE_RING_SIZE; ++slot) {
+    delete[] fSlotBuffers[slot];
+  }
+}
+
+void ReceiveThread::PostReceive(int pSlot) {
+  // The ring of the slot gives the lane to receive from
+  int lane = pSlot / RECEIVE_RING_SIZE;
+  MPI_Irecv(fSlotBuffers[pSlot], RECEIVE_SLOT_SIZE, MPI_BYTE, MPI_ANY_SOURCE, MPI_TAG_MESSAGE + lane,
+            fMPIInterface->GetCommunicator(), &fRequests[pSlot]);
+}
+
+void ReceiveThread::CancelReceives() {
+  for (int slot = 0; slot < LANE_SIZE * RECEIVE_RING_SIZE; ++slot) {
+    if (fRequests[slot] == MPI_REQUEST_NULL) continue;
+    MPI_Cancel(&fRequests[slot]);
+    MPI_Wait(&fRequests[slot], MPI_STATUS_IGNORE);
+  }
 }
 
-AbstractMessage *ReceiveThread::Receive(MPI_Status *pStatus) const {
-  // Declare receiveLength integer
-  int receiveLength;
-  //Get the size of the received message
-  MPI_Get_count(pStatus, MPI_BYTE, &receiveLength);
+const char *ReceiveThread::ReceiveLarge(const char *pFrame, const MPI_Status &pStatus, int &pLength) {
+  // The frame carries the length of the message that follows on the large message tag
+  unsigned int messageLength;
+  memcpy(&messageLength, pFrame + 1, sizeof(messageLength));
+  // Round the buffer up to the next power of two so it is reused for similar sizes
+  if (fLargeBuffer.size() < messageLength) {
+    size_t bufferSize = RECEIVE_SLOT_SIZE;
+    while (bufferSize < messageLength) bufferSize <<= 1;
+    fLargeBuffer.resize(bufferSize);
+  }
+  MPI_Status mpiStatus;
+  fMPIInterface->LockMpi();
+  int lane = pStatus.MPI_TAG - MPI_TAG_MESSAGE;
+  MPI_Recv(fLargeBuffer.data(), messageLength, MPI_BYTE, pStatus.MPI_SOURCE, MPI_TAG_LARGE_MESSAGE + lane,
+           fMPIInterface->GetCommunicator(), &mpiStatus);
+  fMPIInterface->UnlockMpi();
+  pLength = messageLength;
+  return fLargeBuffer.data();
+}
 
-  // FIXME: MPI Probe will cause problem here (message truncated), that's only a temp fix
-  receiveLength = (receiveLength > 65536) ? receiveLength : 65536;
-  //Allocate the receive buffer
-  char *receiveBuffer = new char[receiveLength];
-  //Call MPI_Recv
-  MPI_Recv(receiveBuffer, receiveLength, MPI_BYTE, MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, pStatus);
-  //Convert to string
-  string serialisedMessage = receiveBuffer;
+AbstractMessage *ReceiveThread::Decode(const char *pBuffer, int pLength) const {
+#ifdef BINARY_WIRE_FORMAT
+  // Unpack straight from the receive buffer
+  WireReader wireReader(pBuffer, pLength);
+  //Use the AbstractPool to recreate an instance on the heap
+  AbstractMessage *receivedMessage = messageClassMap->CreateObject(GetTypeID(wireReader));
+  //Unpack the buffer to fill in all message fields.
+  receivedMessage->Unpack(wireReader);
+#else
+  //Convert to string, the sender includes the terminating null in the length
+  string serialisedMessage(pBuffer, pLength - 1);
   //Convert to stream
   istringstream serialisedMessageStream(serialisedMessage, istringstream::in);
   //Use the AbstractPool to recreate an instance on the heap
   AbstractMessage *receivedMessage = messageClassMap->CreateObject(GetTypeID(serialisedMessage));
   //Deserialise the string to fill in all message fields.
   receivedMessage->Deserialise(serialisedMessageStream);
-  // Release memory for the receive buffer
-  delete[] receiveBuffer;
+#endif
   // Return received message
   return receivedMessage;
 }
 
+void ReceiveThread::DecodeEnvelope(const char *pBuffer, int pLength, vector<AbstractMessage *> &pMessages) const {
+  if (pLength < (int) ENVELOPE_HEADER_SIZE || pBuffer[0] != ENVELOPE_MARKER) {
+    // A single message
+    pMessages.push_back(Decode(pBuffer, pLength));
+    return;
+  }
+  WireReader envelopeReader(pBuffer, pLength);
+  char marker;
+  unsigned int messageCount;
+  envelopeReader >> marker >> messageCount;
+  for (unsigned int i = 0; i < messageCount; ++i) {
+    unsigned int messageLength;
+    envelopeReader >> messageLength;
+    if (!envelopeReader.IsGood() || messageLength > envelopeReader.GetRemaining()) {
+      spdlog::critical("ReceiveThread::DecodeEnvelope# Truncated envelope, message {0} of {1}", i, messageCount);
+      exit(1);
+    }
+    size_t messageStart = envelopeReader.GetPosition();
+    pMessages.push_back(Decode(pBuffer + messageStart, messageLength));
+    envelopeReader.SkipTo(messageStart + messageLength);
+  }
+}
+
 void *ReceiveThread::MyThread(void *arg) {
   //Wait to be signalled at startup
   this->Wait();
+  // Post the receive rings of all lanes, the MPI mutex is a no-op when MPI runs with MPI_THREAD_MULTIPLE
+  fMPIInterface->LockMpi();
+  for (int slot = 0; slot < LANE_SIZE * RECEIVE_RING_SIZE; ++slot) {
+    PostReceive(slot);
+  }
+  fMPIInterface->UnlockMpi();
+  int completedCount;
+  int completedSlots[LANE_SIZE * RECEIVE_RING_SIZE];
+  MPI_Status completedStatuses[LANE_SIZE * RECEIVE_RING_SIZE];
+  vector<int> readySlots;
+  vector<AbstractMessage *> receivedMessages;
+  SharedMemoryTransport *sharedMemoryTransport = fMPIInterface->GetSharedMemoryTransport();
+  readySlots.reserve(LANE_SIZE * RECEIVE_RING_SIZE);
+  receivedMessages.reserve(LANE_SIZE * RECEIVE_RING_SIZE);
   // Run this thread while the simulation is running
   while (fIsSimulationRunning) {
-    // Lock the MPI mutex
+    // Test the posted receives, the MPI mutex is only held for the test itself
     fMPIInterface->LockMpi();
-    // Declare the probe flag
-    int probeFlag = 0;
-    // Declare the mpiStatus variable
-    MPI_Status mpiStatus = MPI_Status();
-    // Probe MPI to see if a message is ready
-    MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &probeFlag, &mpiStatus);
-    // Unlock the MPI mutex
+    MPI_Testsome(LANE_SIZE * RECEIVE_RING_SIZE, fRequests, &completedCount, completedSlots, completedStatuses);
     fMPIInterface->UnlockMpi();
-    // Check the probe flag
-    if (probeFlag) {
-      // If there's a message lock the MPI mutex
+    receivedMessages.clear();
+    if (completedCount != MPI_UNDEFINED && completedCount > 0) {
+      for (int i = 0; i < completedCount; ++i) {
+        fStatuses[completedSlots[i]] = completedStatuses[i];
+      }
+      // Take completed slots lane by lane in posting order, a slot completing ahead of an older one waits for it
+      readySlots.clear();
+      for (int lane = 0; lane < LANE_SIZE; ++lane) {
+        int ringStart = lane * RECEIVE_RING_SIZE;
+        int slot = fRingHeads[lane];
+        for (int taken = 0; taken < RECEIVE_RING_SIZE && fRequests[slot] == MPI_REQUEST_NULL; ++taken) {
+          readySlots.push_back(slot);
+          slot = ringStart + (slot - ringStart + 1) % RECEIVE_RING_SIZE;
+        }
+        fRingHeads[lane] = slot;
+      }
+      // Decode in place, oversized messages are fetched after their announcing frame and envelopes are unpacked
+      for (int readySlot : readySlots) {
+        int receiveLength;
+        MPI_Get_count(&fStatuses[readySlot], MPI_BYTE, &receiveLength);
+        const char *receiveBuffer = fSlotBuffers[readySlot];
+        if (receiveLength == (int) LARGE_MESSAGE_FRAME_SIZE && receiveBuffer[0] == LARGE_MESSAGE_MARKER) {
+          receiveBuffer = ReceiveLarge(receiveBuffer, fStatuses[readySlot], receiveLength);
+        }
+        DecodeEnvelope(receiveBuffer, receiveLength, receivedMessages);
+      }
+      // Slot buffers are free again, repost them behind the rest of the ring
       fMPIInterface->LockMpi();
-      // Lock the LP
-      fLp->Lock();
-      // Receive the message through the MPI interface
-      AbstractMessage *receivedMessage = Receive(&mpiStatus);
-      // Put the message on the receive message queue
-      receivedMessage->ReceiveToLp(fLp);
-      // Unlock the LP
-      fLp->Unlock();
-      // Unlock the MPI mutex
+      for (int readySlot : readySlots) {
+        PostReceive(readySlot);
+      }
       fMPIInterface->UnlockMpi();
-      // Signal a receive in the MPI interface
+    }
+    // Envelopes from ranks on the same node, as many as one ring of MPI receives
+    if (sharedMemoryTransport != nullptr) {
+      for (int i = 0; i < RECEIVE_RING_SIZE && sharedMemoryTransport->Receive(fSharedBuffer); ++i) {
+        DecodeEnvelope(fSharedBuffer.data(), fSharedBuffer.size(), receivedMessages);
+      }
+    }
+    if (receivedMessages.empty()) {
+      // Spin, then sleep for longer and longer while no message arrives
+      fBackoff.Idle();
+      continue;
+    }
+    // Put the messages on the receive message queue
+    fLp->Lock();
+    for (AbstractMessage *receivedMessage : receivedMessages) {
+      receivedMessage->ReceiveToLp(fLp);
+    }
+    fLp->Unlock();
+    // Signal a receive in the MPI interface for every message
+    for (size_t i = 0; i < receivedMessages.size(); ++i) {
       fMPIInterface->ReceiveSignal();
-      // Yield the thread after the message has been received
-      sched_yield();
-    } else {
-      // Yield the thread if there's no message
-      sched_yield();
     }
+    fBackoff.Work();
   }
-  // Simulation is no longer running, exit this thread
+  // Simulation is no longer running, withdraw the posted receives and exit this thread
+  fMPIInterface->LockMpi();
+  CancelReceives();
+  fMPIInterface->UnlockMpi();
+  spdlog::info("ReceiveThread::MyThread#Rank {0}: work {1} ms, spin {2} ms, sleep {3} ms in {4} sleeps", fLp->GetRank(),
+               fBackoff.GetWorkTime() / 1000, fBackoff.GetSpinTime() / 1000, fBackoff.GetSleepTime() / 1000,
+               fBackoff.GetSleepCount());
   pthread_exit(0);
 }
 
@@ -93,3 +93,27 @@ void RollbackTag::Deserialise(std::istream& istr) {
   istr >> realTimeStamp;
   istr.ignore(std::numeric_limits<std::streamsize>::max(), DELIM_RIGHT);
 }
+
+/*************************************
+ METHOD: Pack
+
+ DESC: Packs the RollbackTag class into the binary wire format
+
+ ARGS: WireWriter& - the buffer to pack into
+ RETURN: void
+ **************************************/
+void RollbackTag::Pack(WireWriter& pWriter) const {
+  pWriter << originalSsv << time << type << realTimeStamp;
+}
+
+/*************************************
+ METHOD: Unpack
+
+ DESC: Unpacks the RollbackTag class from the binary wire format
+
+ ARGS: WireReader& - the buffer to unpack from
+ RETURN: void
+ **************************************/
+void RollbackTag::Unpack(WireReader& pReader) {
+  pReader >> originalSsv >> time >> type >> realTimeStamp;
+}
@@ -1,4 +1,6 @@
 #include <sstream>
+#include <cstring>
+#include <set>
 #include <mpi.h>
 #include "MpiInterface.h"
 #include "SendThread.h"
@@ -6,12 +8,20 @@
 #include "ObjectMgr.h"
 #include "WriteMessage.h"
 #include "SingleReadResponseMessage.h"
+#include "Helper.h"
+#include "SharedMemoryTransport.h"
 #include <spdlog/spdlog.h>
 using namespace std;
 using namespace pdesmas;
 
 SendThread::SendThread(Lp* pLp, MpiInterface* pMPIInterface) :
-  fIsSimulationRunning(true), fLp(pLp), fMPIInterface(pMPIInterface) {
+  fIsSimulationRunning(true), fLp(pLp), fMPIInterface(pMPIInterface), fOutstandingCount(0) {
+  for (int slot = SEND_PIPELINE_SIZE - 1; slot >= 0; --slot) {
+    fSlots[slot].fIsSending = false;
+    fRequests[2 * slot] = MPI_REQUEST_NULL;
+    fRequests[2 * slot + 1] = MPI_REQUEST_NULL;
+    fFreeSlots.push_back(slot);
+  }
   Start(this);
 }
 
@@ -19,34 +29,191 @@ SendThread::~SendThread() {
   Stop();
 }
 
+void SendThread::ReleaseSlot(int pSlot) {
+  fSlots[pSlot].fIsSending = false;
+  --fOutstandingSends[fSlots[pSlot].fDestination];
+  --fOutstandingCount;
+  fFreeSlots.push_back(pSlot);
+}
+
+int SendThread::CompleteMpiSends() {
+  int completedCount;
+  int completedIndices[2 * SEND_PIPELINE_SIZE];
+  MPI_Testsome(2 * SEND_PIPELINE_SIZE, fRequests, &completedCount, completedIndices, MPI_STATUSES_IGNORE);
+  if (completedCount == MPI_UNDEFINED) return 0;
+  for (int i = 0; i < completedCount; ++i) {
+    int slot = completedIndices[i] / 2;
+    // A slot is free once both of its requests have completed
+    if (!fSlots[slot].fIsSending || fRequests[2 * slot] != MPI_REQUEST_NULL
+        || fRequests[2 * slot + 1] != MPI_REQUEST_NULL) continue;
+    ReleaseSlot(slot);
+  }
+  return completedCount;
+}
+
+int SendThread::CompleteSharedSends() {
+  SharedMemoryTransport* sharedMemoryTransport = fMPIInterface->GetSharedMemoryTransport();
+  int completedCount = 0;
+  // Keep flush order per destination, a destination whose ring is full holds back its later envelopes
+  set<int> fullDestinations;
+  vector<int>::iterator remainingIterator = fSharedSends.begin();
+  for (int slot : fSharedSends) {
+    SendSlot& sendSlot = fSlots[slot];
+    if (fullDestinations.count(sendSlot.fDestination) == 0
+        && sharedMemoryTransport->Send(sendSlot.fDestination, sendSlot.fBuffer.GetData() + sendSlot.fSendOffset,
+                                       sendSlot.fBuffer.GetSize() - sendSlot.fSendOffset, sendSlot.fSharedWritten)) {
+      ReleaseSlot(slot);
+      ++completedCount;
+    } else {
+      fullDestinations.insert(sendSlot.fDestination);
+      *remainingIterator++ = slot;
+    }
+  }
+  fSharedSends.erase(remainingIterator, fSharedSends.end());
+  return completedCount;
+}
+
+void SendThread::CompleteSends(bool pBlocking) {
+  // Close the work period so only the wait itself is booked as idle
+  if (pBlocking) fBackoff.Work();
+  // Envelopes still being collected are counted as outstanding but have nothing to complete
+  while (CompleteMpiSends() + CompleteSharedSends() == 0 && pBlocking && fIsSimulationRunning
+      && fOutstandingCount > fOpenSlots.size()) {
+    // Let the receive thread at MPI while waiting, the destination may need it to make progress
+    fMPIInterface->UnlockSend();
+    fBackoff.Idle();
+    fMPIInterface->LockSend();
+  }
+}
+
+int SendThread::GetEnvelopeKey(int pDestination, MessageLane pLane) {
+  return pDestination * LANE_SIZE + pLane;
+}
+
+int SendThread::OpenSlot(int pDestination, MessageLane pLane) {
+  // Wait for a free slot, simulation messages also wait for the window of the destination
+  while ((fFreeSlots.empty() || (pLane == SIMULATION_LANE && fOutstandingSends[pDestination] >= SEND_WINDOW_SIZE))
+      && fIsSimulationRunning) {
+    // Slots held by envelopes still being collected only free up once sent
+    if (fFreeSlots.empty()) FlushAged(true);
+    CompleteSends(true);
+  }
+  if (fFreeSlots.empty()) return -1;
+  int slot = fFreeSlots.back();
+  fFreeSlots.pop_back();
+  SendSlot& sendSlot = fSlots[slot];
+  sendSlot.fDestination = pDestination;
+  sendSlot.fLane = pLane;
+  sendSlot.fIsSending = false;
+  sendSlot.fMessageCount = 0;
+  sendSlot.fFirstMessageTime = Helper::GetTimeInUS();
+  // Envelope header, the message count is filled in on flush
+  sendSlot.fBuffer.Clear();
+  sendSlot.fBuffer << ENVELOPE_MARKER << sendSlot.fMessageCount;
+  ++fOutstandingSends[pDestination];
+  ++fOutstandingCount;
+  fOpenSlots[GetEnvelopeKey(pDestination, pLane)] = slot;
+  return slot;
+}
+
+void SendThread::Flush(int pEnvelopeKey) {
+  map<int, int>::iterator openSlotIterator = fOpenSlots.find(pEnvelopeKey);
+  if (openSlotIterator == fOpenSlots.end()) return;
+  int slot = openSlotIterator->second;
+  fOpenSlots.erase(openSlotIterator);
+  SendSlot& sendSlot = fSlots[slot];
+  int destination = sendSlot.fDestination;
+  sendSlot.fSendOffset = 0;
+  if (sendSlot.fMessageCount == 1) {
+    // A single message goes out as is, without envelope header and length
+    sendSlot.fSendOffset = ENVELOPE_HEADER_SIZE + sizeof(unsigned int);
+  } else {
+    sendSlot.fBuffer.WriteAt(1, &sendSlot.fMessageCount, sizeof(sendSlot.fMessageCount));
+  }
+  sendSlot.fIsSending = true;
+  SharedMemoryTransport* sharedMemoryTransport = fMPIInterface->GetSharedMemoryTransport();
+  if (sharedMemoryTransport != nullptr && sharedMemoryTransport->IsLocal(destination)) {
+    // Same node, written to shared memory as far as the ring has space and finished by CompleteSends
+    sendSlot.fSharedWritten = 0;
+    fSharedSends.push_back(slot);
+    CompleteSharedSends();
+    return;
+  }
+  const char* sendBuffer = sendSlot.fBuffer.GetData() + sendSlot.fSendOffset;
+  size_t sendLength = sendSlot.fBuffer.GetSize() - sendSlot.fSendOffset;
+  MPI_Comm communicator = fMPIInterface->GetCommunicator();
+  int lane = sendSlot.fLane;
+  if (sendLength > RECEIVE_SLOT_SIZE) {
+    // Too large for a receive slot, announce the length and send the message on the large message tag
+    unsigned int messageLength = sendLength;
+    sendSlot.fLargeMessageFrame[0] = LARGE_MESSAGE_MARKER;
+    memcpy(sendSlot.fLargeMessageFrame + 1, &messageLength, sizeof(messageLength));
+    MPI_Isend(sendSlot.fLargeMessageFrame, LARGE_MESSAGE_FRAME_SIZE, MPI_BYTE, destination, MPI_TAG_MESSAGE + lane,
+              communicator, &fRequests[2 * slot]);
+    MPI_Isend((void*) sendBuffer, (int) sendLength, MPI_BYTE, destination, MPI_TAG_LARGE_MESSAGE + lane, communicator,
+              &fRequests[2 * slot + 1]);
+  } else {
+    // Send envelope through MPI, the slot buffer stays untouched until the send completes
+    MPI_Isend((void*) sendBuffer, (int) sendLength, MPI_BYTE, destination, MPI_TAG_MESSAGE + lane, communicator,
+              &fRequests[2 * slot]);
+  }
+}
+
+void SendThread::FlushAged(bool pFlushAll) {
+  unsigned long now = Helper::GetTimeInUS();
+  vector<int> envelopeKeys;
+  for (map<int, int>::const_iterator openSlotIterator = fOpenSlots.begin(); openSlotIterator != fOpenSlots.end();
+       ++openSlotIterator) {
+    if (pFlushAll || now - fSlots[openSlotIterator->second].fFirstMessageTime >= COALESCE_MAX_DELAY) {
+      envelopeKeys.push_back(openSlotIterator->first);
+    }
+  }
+  for (int envelopeKey : envelopeKeys) {
+    Flush(envelopeKey);
+  }
+}
+
+void SendThread::FlushAll() {
+  FlushAged(true);
+}
+
 void SendThread::Send(AbstractMessage* sendMessage) {
+  int destination = sendMessage->GetDestination();
+  MessageLane lane = sendMessage->GetLane();
+  int envelopeKey = GetEnvelopeKey(destination, lane);
+  fEncodeBuffer.Clear();
+#ifdef BINARY_WIRE_FORMAT
+  // Pack message into the binary wire format
+  sendMessage->Pack(fEncodeBuffer);
+#else
   // Declare output string stream
   ostringstream serialisedMessageStream(ostringstream::out);
   //Serialise message into stream
   sendMessage->Serialise(serialisedMessageStream);
-  //Convert stream into string
+  //Convert stream into string, the message is sent including the terminating null
   string serialisedMessage = serialisedMessageStream.str();
-  //Get string length
-  size_t stringLength = strlen(serialisedMessage.c_str()) + 1;
-  // Declare byte array for message
-  char* sendBuffer = new char[stringLength];
-  // Copy serialised message into byte array
-  strcpy(sendBuffer, serialisedMessage.c_str());
-  // Declare tag and MPI request variable
-  int send_tag = 0;
-  MPI_Request mpiRequest;
-  // Send message through MPI
-  MPI_Isend(sendBuffer, (int) stringLength, MPI_BYTE, sendMessage->GetDestination(), send_tag, MPI_COMM_WORLD, &mpiRequest);
-  // Declare send flag and MPI status
-  int sendFlag = 0;
-  MPI_Status mpiStatus;
-  // Wait until the send message part has been completed
-  while (sendFlag == 0 && fIsSimulationRunning) {
-    MPI_Test(&mpiRequest, &sendFlag, &mpiStatus);
+  fEncodeBuffer.Write(serialisedMessage.c_str(), serialisedMessage.size() + 1);
+#endif
+  unsigned int messageLength = fEncodeBuffer.GetSize();
+  // Send the open envelope first if this message would take it over budget
+  map<int, int>::const_iterator openSlotIterator = fOpenSlots.find(envelopeKey);
+  if (openSlotIterator != fOpenSlots.end()
+      && fSlots[openSlotIterator->second].fBuffer.GetSize() + sizeof(messageLength) + messageLength
+          > COALESCE_MAX_BYTES) {
+    Flush(envelopeKey);
+    openSlotIterator = fOpenSlots.end();
   }
-  // Message has been send free memory for the send buffer
-  delete[] sendBuffer;
-  // Message has been send. Will need to free the memory for value first.
+  int slot = (openSlotIterator != fOpenSlots.end()) ? openSlotIterator->second : OpenSlot(destination, lane);
+  if (slot >= 0) {
+    // Append the message to the envelope
+    SendSlot& sendSlot = fSlots[slot];
+    sendSlot.fBuffer << messageLength;
+    sendSlot.fBuffer.Write(fEncodeBuffer.GetData(), messageLength);
+    ++sendSlot.fMessageCount;
+    // Control and load balancing messages do not wait for more messages to coalesce with
+    if (lane != SIMULATION_LANE || sendSlot.fBuffer.GetSize() >= COALESCE_MAX_BYTES) Flush(envelopeKey);
+  }
+  // Message has been encoded. Will need to free the memory for value first.
   switch (sendMessage->GetType()) {
     case SINGLEREADRESPONSEMESSAGE:
       static_cast<SingleReadResponseMessage*> (sendMessage)->ClearValue();
@@ -66,15 +233,39 @@ void* SendThread::MyThread(void* arg) {
   //Wait to be signalled at startup
   this->Wait();
   while (fIsSimulationRunning) {
-    //Wait on semaphore until we're signalled to send
-    fMPIInterface->SendWait();
+    //Wait on semaphore until we're signalled to send, polling for completions while sends are in flight
+    if (fOutstandingCount == 0) {
+      fMPIInterface->SendWait();
+      fBackoff.Skip();
+    } else if (!fMPIInterface->SendWait(SEND_POLL_INTERVAL)) {
+      fBackoff.Skip();
+      fMPIInterface->LockSend();
+      FlushAged(false);
+      CompleteSends(false);
+      fMPIInterface->UnlockSend();
+      fBackoff.Work();
+      continue;
+    } else {
+      fBackoff.Skip();
+    }
 
     if (fIsSimulationRunning) {
-      fMPIInterface->LockMpi();
-      fLp->Send();
-      fMPIInterface->UnlockMpi();
+      fMPIInterface->LockSend();
+      // Drain a batch of messages, each further message consumes its own signal
+      bool isSent = fLp->Send();
+      for (unsigned int batch = 1; isSent && batch < SEND_BATCH_SIZE && fMPIInterface->SendTryWait(); ++batch) {
+        isSent = fLp->Send();
+      }
+      // Send the envelopes that used up their delay budget
+      FlushAged(false);
+      CompleteSends(false);
+      fMPIInterface->UnlockSend();
+      fBackoff.Work();
     }
   }
+  spdlog::info("SendThread::MyThread#Rank {0}: work {1} ms, spin {2} ms, sleep {3} ms in {4} sleeps", fLp->GetRank(),
+               fBackoff.GetWorkTime() / 1000, fBackoff.GetSpinTime() / 1000, fBackoff.GetSleepTime() / 1000,
+               fBackoff.GetSleepCount());
   pthread_exit(0);
 }
 
@@ -0,0 +1,138 @@
+#include <cstring>
+#include <new>
+#include "SharedMemoryTransport.h"
+#include <spdlog/spdlog.h>
+
+using namespace std;
+using namespace pdesmas;
+
+static_assert((SHARED_RING_SIZE & (SHARED_RING_SIZE - 1)) == 0, "SHARED_RING_SIZE must be a power of two");
+
+SharedMemoryTransport::SharedMemoryTransport(MPI_Comm pCommunicator) :
+    fWindow(MPI_WIN_NULL), fNextRing(0) {
+  if (!atomic<unsigned long>().is_lock_free()) {
+    spdlog::critical("SharedMemoryTransport::SharedMemoryTransport# Ring indices are not lock free");
+    exit(1);
+  }
+  MPI_Comm_split_type(pCommunicator, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &fNodeCommunicator);
+  MPI_Comm_rank(fNodeCommunicator, &fNodeRank);
+  MPI_Comm_size(fNodeCommunicator, &fNodeSize);
+  // Translate the ranks of the message communicator to node ranks
+  int size;
+  MPI_Comm_size(pCommunicator, &size);
+  vector<int> ranks(size);
+  for (int rank = 0; rank < size; ++rank) ranks[rank] = rank;
+  fNodeRanks.resize(size);
+  MPI_Group group, nodeGroup;
+  MPI_Comm_group(pCommunicator, &group);
+  MPI_Comm_group(fNodeCommunicator, &nodeGroup);
+  MPI_Group_translate_ranks(group, size, ranks.data(), nodeGroup, fNodeRanks.data());
+  MPI_Group_free(&group);
+  MPI_Group_free(&nodeGroup);
+  for (int rank = 0; rank < size; ++rank) {
+    if (fNodeRanks[rank] == MPI_UNDEFINED) fNodeRanks[rank] = -1;
+  }
+  // Each rank gets its own segment so the rings start on a page boundary
+  MPI_Info info;
+  MPI_Info_create(&info);
+  MPI_Info_set(info, "alloc_shared_noncontig", "true");
+  SharedRing* inboundRings;
+  MPI_Win_allocate_shared(fNodeSize * sizeof(SharedRing), sizeof(SharedRing), info, fNodeCommunicator,
+                          &inboundRings, &fWindow);
+  MPI_Info_free(&info);
+  for (int nodeRank = 0; nodeRank < fNodeSize; ++nodeRank) {
+    SharedRing* ring = new(&inboundRings[nodeRank]) SharedRing;
+    ring->fHead.store(0, memory_order_relaxed);
+    ring->fTail.store(0, memory_order_relaxed);
+    fInboundRings.push_back(ring);
+  }
+  fPendingMessages.resize(fNodeSize);
+  for (PendingMessage& pendingMessage : fPendingMessages) {
+    pendingMessage.fHasLength = false;
+  }
+  // All rings are initialised before anyone writes to them
+  MPI_Barrier(fNodeCommunicator);
+  for (int nodeRank = 0; nodeRank < fNodeSize; ++nodeRank) {
+    MPI_Aint segmentSize;
+    int displacementUnit;
+    SharedRing* rings;
+    MPI_Win_shared_query(fWindow, nodeRank, &segmentSize, &displacementUnit, &rings);
+    fOutboundRings.push_back(&rings[fNodeRank]);
+  }
+}
+
+SharedMemoryTransport::~SharedMemoryTransport() {
+  // The window is released by MPI_Finalize, freeing it here would need all node ranks to take part
+}
+
+bool SharedMemoryTransport::IsLocal(int pRank) const {
+  return fNodeRanks[pRank] >= 0;
+}
+
+bool SharedMemoryTransport::HasLocalRanks() const {
+  return fNodeSize > 1;
+}
+
+void SharedMemoryTransport::CopyIn(SharedRing* pRing, unsigned long pPosition, const char* pData, size_t pLength) {
+  size_t offset = pPosition & (SHARED_RING_SIZE - 1);
+  size_t firstPart = min(pLength, (size_t) SHARED_RING_SIZE - offset);
+  memcpy(pRing->fData + offset, pData, firstPart);
+  memcpy(pRing->fData, pData + firstPart, pLength - firstPart);
+}
+
+void SharedMemoryTransport::CopyOut(const SharedRing* pRing, unsigned long pPosition, char* pData, size_t pLength) {
+  size_t offset = pPosition & (SHARED_RING_SIZE - 1);
+  size_t firstPart = min(pLength, (size_t) SHARED_RING_SIZE - offset);
+  memcpy(pData, pRing->fData + offset, firstPart);
+  memcpy(pData + firstPart, pRing->fData, pLength - firstPart);
+}
+
+bool SharedMemoryTransport::Send(int pDestination, const char* pData, size_t pLength, size_t& pWritten) {
+  SharedRing* ring = fOutboundRings[fNodeRanks[pDestination]];
+  unsigned long tail = ring->fTail.load(memory_order_relaxed);
+  size_t space = SHARED_RING_SIZE - (tail - ring->fHead.load(memory_order_acquire));
+  unsigned int messageLength = pLength;
+  if (pWritten == 0) {
+    // The length goes in whole, the reader never sees half of it
+    if (space < sizeof(messageLength)) return false;
+    CopyIn(ring, tail, (const char*) &messageLength, sizeof(messageLength));
+    tail += sizeof(messageLength);
+    space -= sizeof(messageLength);
+    pWritten = sizeof(messageLength);
+  }
+  size_t part = min(space, pLength - (pWritten - sizeof(messageLength)));
+  CopyIn(ring, tail, pData + pWritten - sizeof(messageLength), part);
+  pWritten += part;
+  ring->fTail.store(tail + part, memory_order_release);
+  return pWritten == pLength + sizeof(messageLength);
+}
+
+bool SharedMemoryTransport::Receive(vector<char>& pMessage) {
+  for (int i = 0; i < fNodeSize; ++i) {
+    int nodeRank = (fNextRing + i) % fNodeSize;
+    SharedRing* ring = fInboundRings[nodeRank];
+    PendingMessage& pendingMessage = fPendingMessages[nodeRank];
+    unsigned long head = ring->fHead.load(memory_order_relaxed);
+    size_t available = ring->fTail.load(memory_order_acquire) - head;
+    if (!pendingMessage.fHasLength) {
+      if (available < sizeof(pendingMessage.fLength)) continue;
+      CopyOut(ring, head, (char*) &pendingMessage.fLength, sizeof(pendingMessage.fLength));
+      head += sizeof(pendingMessage.fLength);
+      available -= sizeof(pendingMessage.fLength);
+      pendingMessage.fHasLength = true;
+      pendingMessage.fReceived = 0;
+      pendingMessage.fBuffer.resize(pendingMessage.fLength);
+    }
+    size_t part = min(available, (size_t) (pendingMessage.fLength - pendingMessage.fReceived));
+    CopyOut(ring, head, pendingMessage.fBuffer.data() + pendingMessage.fReceived, part);
+    pendingMessage.fReceived += part;
+    ring->fHead.store(head + part, memory_order_release);
+    if (pendingMessage.fReceived < pendingMessage.fLength) continue;
+    // Complete, hand the buffer over and keep the caller's for the next message
+    pMessage.swap(pendingMessage.fBuffer);
+    pendingMessage.fHasLength = false;
+    fNextRing = (nodeRank + 1) % fNodeSize;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,74 @@
+#include "ThreadedNetwork.h"
+#include <spdlog/spdlog.h>
+
+using namespace std;
+using namespace pdesmas;
+
+ThreadedNetwork* ThreadedNetwork::fInstance = nullptr;
+thread_local int ThreadedNetwork::fThreadRank = -1;
+
+ThreadedNetwork::ThreadedNetwork(unsigned int pSize, int (*pMain)(int, char**), int pArgc, char** pArgv) :
+    fSize(pSize), fMain(pMain), fArgc(pArgc), fArgv(pArgv), fTransports(pSize, nullptr), fReturnValues(pSize, 0) {
+  pthread_barrier_init(&fBarrier, nullptr, pSize);
+}
+
+ThreadedNetwork::~ThreadedNetwork() {
+  pthread_barrier_destroy(&fBarrier);
+}
+
+void* ThreadedNetwork::RunLp(void* pArgument) {
+  LpThread* lpThread = static_cast<LpThread*>(pArgument);
+  fThreadRank = lpThread->fRank;
+  ThreadedNetwork* network = lpThread->fNetwork;
+  network->fReturnValues[lpThread->fRank] = network->fMain(network->fArgc, network->fArgv);
+  return 0;
+}
+
+int ThreadedNetwork::Run(unsigned int pSize, int (*pMain)(int, char**), int pArgc, char** pArgv) {
+  if (fInstance != nullptr) {
+    spdlog::critical("ThreadedNetwork::Run# A threaded network is already running");
+    exit(1);
+  }
+  fInstance = new ThreadedNetwork(pSize, pMain, pArgc, pArgv);
+  vector<LpThread> lpThreads(pSize);
+  for (unsigned int rank = 0; rank < pSize; ++rank) {
+    lpThreads[rank].fNetwork = fInstance;
+    lpThreads[rank].fRank = rank;
+    if (pthread_create(&lpThreads[rank].fThreadID, 0, RunLp, &lpThreads[rank]) != 0) {
+      spdlog::critical("ThreadedNetwork::Run# Could not start the thread for LP {0}", rank);
+      exit(1);
+    }
+  }
+  int returnValue = 0;
+  for (unsigned int rank = 0; rank < pSize; ++rank) {
+    pthread_join(lpThreads[rank].fThreadID, nullptr);
+    if (returnValue == 0) returnValue = fInstance->fReturnValues[rank];
+  }
+  delete fInstance;
+  fInstance = nullptr;
+  return returnValue;
+}
+
+ThreadedNetwork* ThreadedNetwork::GetInstance() {
+  return fInstance;
+}
+
+unsigned int ThreadedNetwork::GetSize() const {
+  return fSize;
+}
+
+unsigned int ThreadedNetwork::GetRank() const {
+  return fThreadRank;
+}
+
+void ThreadedNetwork::Barrier() {
+  pthread_barrier_wait(&fBarrier);
+}
+
+void ThreadedNetwork::AddTransport(unsigned int pRank, ThreadedTransport* pTransport) {
+  fTransports[pRank] = pTransport;
+}
+
+ThreadedTransport* ThreadedNetwork::GetTransport(unsigned int pRank) const {
+  return fTransports[pRank];
+}
@@ -0,0 +1,79 @@
+#include "ThreadedTransport.h"
+#include "ThreadedNetwork.h"
+#include "Lp.h"
+
+using namespace std;
+using namespace pdesmas;
+
+ThreadedTransport::ThreadedTransport(Lp* pLp, ThreadedNetwork* pNetwork) :
+    fLp(pLp), fNetwork(pNetwork), fIsSimulationRunning(true) {
+  fNetwork->AddTransport(fLp->GetRank(), this);
+  // Thread::Start hands the argument to MyThread as a Thread
+  Start(static_cast<Thread*>(this));
+}
+
+ThreadedTransport::~ThreadedTransport() {
+  // The send thread is cancelled by ~Thread
+}
+
+void* ThreadedTransport::MyThread(void* arg) {
+  //Wait to be signalled at startup
+  this->Wait();
+  while (fIsSimulationRunning) {
+    fSendSemaphore.Wait();
+    if (fIsSimulationRunning) fLp->Send();
+  }
+  pthread_exit(0);
+}
+
+void ThreadedTransport::Deliver(AbstractMessage* pMessage) {
+  fInboxMutex.Lock();
+  fInbox.push_back(pMessage);
+  fInboxMutex.Unlock();
+  fReceiveSemaphore.Signal();
+}
+
+void ThreadedTransport::Signal() {
+  Thread::Signal();
+}
+
+void ThreadedTransport::StopSimulation() {
+  fIsSimulationRunning = false;
+  SendSignal();
+}
+
+void ThreadedTransport::Join() {
+  Thread::Join();
+}
+
+void ThreadedTransport::Stop() {
+  Thread::Stop();
+}
+
+void ThreadedTransport::Send(AbstractMessage* pMessage) {
+  // The destination owns the message from here, values included
+  fNetwork->GetTransport(pMessage->GetDestination())->Deliver(pMessage);
+}
+
+void ThreadedTransport::ReceiveWait() {
+  fReceiveSemaphore.Wait();
+  // Every delivery signals once, an earlier wait may already have taken this message
+  fInboxMutex.Lock();
+  fReceivedMessages.swap(fInbox);
+  fInboxMutex.Unlock();
+  if (fReceivedMessages.empty()) return;
+  fLp->Lock();
+  for (AbstractMessage* receivedMessage : fReceivedMessages) {
+    receivedMessage->ReceiveToLp(fLp);
+  }
+  fLp->Unlock();
+  fReceivedMessages.clear();
+}
+
+void ThreadedTransport::SendSignal() {
+  fSendSemaphore.Signal();
+}
+
+void ThreadedTransport::Barrier() {
+  fNetwork->Barrier();
+}
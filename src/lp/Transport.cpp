@@ -0,0 +1,12 @@
+#include "Transport.h"
+#include "MpiInterface.h"
+#include "ThreadedNetwork.h"
+#include "ThreadedTransport.h"
+
+using namespace pdesmas;
+
+Transport* Transport::Create(Lp* pLp) {
+  ThreadedNetwork* threadedNetwork = ThreadedNetwork::GetInstance();
+  if (threadedNetwork != nullptr) return new ThreadedTransport(pLp, threadedNetwork);
+  return new MpiInterface(pLp, pLp);
+}
@@ -1,5 +1,6 @@
 #include "AbstractMessage.h"
 #include "ObjectMgr.h"
+#include "spdlog/spdlog.h"
 
 using namespace pdesmas;
 
@@ -18,3 +19,61 @@ void AbstractMessage::RegisterClass(pdesmasType pType, AbstractMessage* (*pCreat
 AbstractMessage* AbstractMessage::RecreateInstance(pdesmasType pType) {
   return messageClassMap->CreateObject(pType);
 }
+
+unsigned long AbstractMessage::GetWireTimestamp() const {
+  return 0;
+}
+
+void AbstractMessage::SetWireTimestamp(unsigned long) {
+  // No timestamp
+}
+
+MatternColour AbstractMessage::GetWireColour() const {
+  return WHITE;
+}
+
+void AbstractMessage::SetWireColour(MatternColour) {
+  // No colour
+}
+
+void AbstractMessage::Pack(WireWriter& pWriter) const {
+  unsigned char version = WIRE_FORMAT_VERSION;
+  pWriter << version << GetType() << fOrigin << fDestination;
+  pWriter << GetWireTimestamp() << GetWireColour();
+  // Payload length is filled in once the payload is written
+  size_t lengthOffset = pWriter.GetSize();
+  unsigned int payloadLength = 0;
+  pWriter << payloadLength;
+  PackPayload(pWriter);
+  payloadLength = pWriter.GetSize() - lengthOffset - sizeof(payloadLength);
+  pWriter.WriteAt(lengthOffset, &payloadLength, sizeof(payloadLength));
+}
+
+void AbstractMessage::Unpack(WireReader& pReader) {
+  unsigned char version;
+  pReader >> version;
+  if (version != WIRE_FORMAT_VERSION) {
+    spdlog::critical("AbstractMessage::Unpack# Wire format version mismatch, expected {0}, received {1}",
+                     WIRE_FORMAT_VERSION, version);
+    exit(1);
+  }
+  pdesmasType type;
+  unsigned long timestamp;
+  MatternColour colour;
+  unsigned int payloadLength;
+  pReader >> type >> fOrigin >> fDestination >> timestamp >> colour >> payloadLength;
+  if (type != GetType()) {
+    spdlog::critical("AbstractMessage::Unpack# Message type mismatch, expected {0}, received {1}", GetType(), type);
+    exit(1);
+  }
+  SetWireTimestamp(timestamp);
+  SetWireColour(colour);
+  size_t payloadEnd = pReader.GetPosition() + payloadLength;
+  UnpackPayload(pReader);
+  // Skip fields appended by a newer revision of the same format version
+  pReader.SkipTo(payloadEnd);
+  if (!pReader.IsGood()) {
+    spdlog::critical("AbstractMessage::Unpack# Truncated message of type {0}", type);
+    exit(1);
+  }
+}
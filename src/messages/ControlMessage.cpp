@@ -18,5 +18,9 @@ void ControlMessage::SendToLp(Lp *pLp) const {
 }
 
 void ControlMessage::ReceiveToLp(Lp *pLp) const {
-  pLp->fReceiveMessageQueue->QueueMessage((AbstractMessage*) this);
+  pLp->fReceiveControlMessageQueue->QueueMessage((AbstractMessage*) this);
+}
+
+MessageLane ControlMessage::GetLane() const {
+  return CONTROL_LANE;
 }
@@ -35,3 +35,11 @@ void EndMessage::Deserialise(istream& pIstream) {
   pIstream >> fSenderAlp;
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
+
+void EndMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fSenderAlp;
+}
+
+void EndMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fSenderAlp;
+}
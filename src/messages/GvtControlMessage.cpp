@@ -48,3 +48,11 @@ void GvtControlMessage::Deserialise(istream &pIstream) {
   // DONT CHANGE THE ORDER!!!
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
+
+void GvtControlMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fMessageMinimumTime << fRedMessageTime << fMatternCut << fMessageCount << agentTimeHistoryRecord;
+}
+
+void GvtControlMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fMessageMinimumTime >> fRedMessageTime >> fMatternCut >> fMessageCount >> agentTimeHistoryRecord;
+}
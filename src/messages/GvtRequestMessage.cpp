@@ -32,3 +32,11 @@ void GvtRequestMessage::Deserialise(istream& pIstream) {
   pIstream >> fDestination;
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
+
+void GvtRequestMessage::PackPayload(WireWriter&) const {
+  // No payload
+}
+
+void GvtRequestMessage::UnpackPayload(WireReader&) {
+  // No payload
+}
@@ -35,3 +35,11 @@ void GvtValueMessage::Deserialise(istream& pIstream) {
   pIstream >> fGVT;
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
+
+void GvtValueMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fGVT;
+}
+
+void GvtValueMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fGVT;
+}
@@ -19,3 +19,7 @@ void LoadBalancingMessage::SendToLp(Lp *pLp) const {
 void LoadBalancingMessage::ReceiveToLp(Lp *pLp) const {
   pLp->fReceiveLoadBalancingMessageQueue->QueueMessage((AbstractMessage*) this);
 }
+
+MessageLane LoadBalancingMessage::GetLane() const {
+  return LOAD_BALANCING_LANE;
+}
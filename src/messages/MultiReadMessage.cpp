@@ -0,0 +1,60 @@
+#include "MultiReadMessage.h"
+
+using namespace pdesmas;
+
+MultiReadMessage::MultiReadMessage() {
+  RegisterClass(GetType(), &CreateInstance);
+}
+
+MultiReadMessage::~MultiReadMessage() {
+  // Empty deconstructor
+}
+
+pdesmasType MultiReadMessage::GetType() const {
+  return MULTIREADMESSAGE;
+}
+
+AbstractMessage* MultiReadMessage::CreateInstance() {
+  return new MultiReadMessage;
+}
+
+void MultiReadMessage::Serialise(ostream& pOstream) const {
+  pOstream << DELIM_LEFT << GetType();
+  pOstream << DELIM_VAR_SEPARATOR << fOrigin;
+  pOstream << DELIM_VAR_SEPARATOR << fDestination;
+  pOstream << DELIM_VAR_SEPARATOR << fTimestamp;
+  pOstream << DELIM_VAR_SEPARATOR << fMatternColour;
+  pOstream << DELIM_VAR_SEPARATOR << fNumberOfHops;
+  pOstream << DELIM_VAR_SEPARATOR << fIdentifier;
+  pOstream << DELIM_VAR_SEPARATOR << original_agent_;
+  pOstream << DELIM_VAR_SEPARATOR << fSsvIdList;
+  pOstream << DELIM_RIGHT;
+}
+
+void MultiReadMessage::Deserialise(istream& pIstream) {
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fOrigin;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fDestination;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fTimestamp;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fMatternColour;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fNumberOfHops;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fIdentifier;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> original_agent_;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fSsvIdList;
+  IgnoreTo(pIstream, DELIM_RIGHT);
+}
+
+void MultiReadMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fNumberOfHops << fIdentifier << original_agent_ << fSsvIdList;
+}
+
+void MultiReadMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fNumberOfHops >> fIdentifier >> original_agent_ >> fSsvIdList;
+}
@@ -0,0 +1,60 @@
+#include "MultiReadResponseMessage.h"
+
+using namespace pdesmas;
+
+MultiReadResponseMessage::MultiReadResponseMessage() {
+  RegisterClass(GetType(), &CreateInstance);
+}
+
+MultiReadResponseMessage::~MultiReadResponseMessage() {
+  // Empty deconstructor
+}
+
+pdesmasType MultiReadResponseMessage::GetType() const {
+  return MULTIREADRESPONSEMESSAGE;
+}
+
+AbstractMessage* MultiReadResponseMessage::CreateInstance() {
+  return new MultiReadResponseMessage;
+}
+
+void MultiReadResponseMessage::Serialise(ostream& pOstream) const {
+  pOstream << DELIM_LEFT << GetType();
+  pOstream << DELIM_VAR_SEPARATOR << fOrigin;
+  pOstream << DELIM_VAR_SEPARATOR << fDestination;
+  pOstream << DELIM_VAR_SEPARATOR << fTimestamp;
+  pOstream << DELIM_VAR_SEPARATOR << fMatternColour;
+  pOstream << DELIM_VAR_SEPARATOR << fIdentifier;
+  pOstream << DELIM_VAR_SEPARATOR << original_agent_;
+  pOstream << DELIM_VAR_SEPARATOR;
+  SerialiseSsvIdValueList(pOstream);
+  pOstream << DELIM_RIGHT;
+}
+
+void MultiReadResponseMessage::Deserialise(istream& pIstream) {
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fOrigin;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fDestination;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fTimestamp;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fMatternColour;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fIdentifier;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> original_agent_;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  DeserialiseSsvIdValueList(pIstream);
+  IgnoreTo(pIstream, DELIM_RIGHT);
+}
+
+void MultiReadResponseMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fIdentifier << original_agent_;
+  PackSsvIdValueList(pWriter);
+}
+
+void MultiReadResponseMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fIdentifier >> original_agent_;
+  UnpackSsvIdValueList(pReader);
+}
@@ -0,0 +1,63 @@
+#include "MultiWriteMessage.h"
+
+using namespace pdesmas;
+
+MultiWriteMessage::MultiWriteMessage() {
+  RegisterClass(GetType(), &CreateInstance);
+}
+
+MultiWriteMessage::~MultiWriteMessage() {
+  // Empty deconstructor
+}
+
+pdesmasType MultiWriteMessage::GetType() const {
+  return MULTIWRITEMESSAGE;
+}
+
+AbstractMessage* MultiWriteMessage::CreateInstance() {
+  return new MultiWriteMessage;
+}
+
+void MultiWriteMessage::Serialise(ostream& pOstream) const {
+  pOstream << DELIM_LEFT << GetType();
+  pOstream << DELIM_VAR_SEPARATOR << fOrigin;
+  pOstream << DELIM_VAR_SEPARATOR << fDestination;
+  pOstream << DELIM_VAR_SEPARATOR << fTimestamp;
+  pOstream << DELIM_VAR_SEPARATOR << fMatternColour;
+  pOstream << DELIM_VAR_SEPARATOR << fNumberOfHops;
+  pOstream << DELIM_VAR_SEPARATOR << fIdentifier;
+  pOstream << DELIM_VAR_SEPARATOR << original_agent_;
+  pOstream << DELIM_VAR_SEPARATOR;
+  SerialiseSsvIdValueList(pOstream);
+  pOstream << DELIM_RIGHT;
+}
+
+void MultiWriteMessage::Deserialise(istream& pIstream) {
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fOrigin;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fDestination;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fTimestamp;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fMatternColour;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fNumberOfHops;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fIdentifier;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> original_agent_;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  DeserialiseSsvIdValueList(pIstream);
+  IgnoreTo(pIstream, DELIM_RIGHT);
+}
+
+void MultiWriteMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fNumberOfHops << fIdentifier << original_agent_;
+  PackSsvIdValueList(pWriter);
+}
+
+void MultiWriteMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fNumberOfHops >> fIdentifier >> original_agent_;
+  UnpackSsvIdValueList(pReader);
+}
@@ -0,0 +1,58 @@
+#include "MultiWriteResponseMessage.h"
+#include "MultiWriteMessage.h"
+
+using namespace pdesmas;
+
+MultiWriteResponseMessage::MultiWriteResponseMessage() {
+  RegisterClass(GetType(), &CreateInstance);
+}
+
+MultiWriteResponseMessage::~MultiWriteResponseMessage() {
+  // Empty deconstructor
+}
+
+pdesmasType MultiWriteResponseMessage::GetType() const {
+  return MULTIWRITERESPONSEMESSAGE;
+}
+
+AbstractMessage* MultiWriteResponseMessage::CreateInstance() {
+  return new MultiWriteResponseMessage;
+}
+
+void MultiWriteResponseMessage::Serialise(ostream& pOstream) const {
+  pOstream << DELIM_LEFT << GetType();
+  pOstream << DELIM_VAR_SEPARATOR << fOrigin;
+  pOstream << DELIM_VAR_SEPARATOR << fDestination;
+  pOstream << DELIM_VAR_SEPARATOR << fTimestamp;
+  pOstream << DELIM_VAR_SEPARATOR << fMatternColour;
+  pOstream << DELIM_VAR_SEPARATOR << fIdentifier;
+  pOstream << DELIM_VAR_SEPARATOR << original_agent_;
+  pOstream << DELIM_VAR_SEPARATOR << fSsvIdWriteStatusMap;
+  pOstream << DELIM_RIGHT;
+}
+
+void MultiWriteResponseMessage::Deserialise(istream& pIstream) {
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fOrigin;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fDestination;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fTimestamp;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fMatternColour;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fIdentifier;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> original_agent_;
+  IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+  pIstream >> fSsvIdWriteStatusMap;
+  IgnoreTo(pIstream, DELIM_RIGHT);
+}
+
+void MultiWriteResponseMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fIdentifier << original_agent_ << fSsvIdWriteStatusMap;
+}
+
+void MultiWriteResponseMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fIdentifier >> original_agent_ >> fSsvIdWriteStatusMap;
+}
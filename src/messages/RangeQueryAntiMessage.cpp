@@ -53,3 +53,11 @@ void RangeQueryAntiMessage::Deserialise(istream& pIstream) {
   pIstream >> fIdentifier;
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
+
+void RangeQueryAntiMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fNumberOfHops << fRollbackTag << original_agent_ << fRange << fIdentifier;
+}
+
+void RangeQueryAntiMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fNumberOfHops >> fRollbackTag >> original_agent_ >> fRange >> fIdentifier;
+}
@@ -56,3 +56,11 @@ void RangeQueryMessage::Deserialise(istream& pIstream) {
   pIstream >> fSsvIdValueMap;
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
+
+void RangeQueryMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fNumberOfHops << fIdentifier << original_agent_ << fRange << fNumberOfTraverseHops << fSsvIdValueMap;
+}
+
+void RangeQueryMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fNumberOfHops >> fIdentifier >> original_agent_ >> fRange >> fNumberOfTraverseHops >> fSsvIdValueMap;
+}
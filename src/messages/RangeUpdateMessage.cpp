@@ -18,6 +18,14 @@ AbstractMessage* RangeUpdateMessage::CreateInstance() {
   return new RangeUpdateMessage;
 }
 
+unsigned long RangeUpdateMessage::GetWireTimestamp() const {
+  return fTimestamp;
+}
+
+void RangeUpdateMessage::SetWireTimestamp(unsigned long pTimestamp) {
+  fTimestamp = pTimestamp;
+}
+
 void RangeUpdateMessage::Serialise(ostream& pOstream) const {
   pOstream << DELIM_LEFT << GetType();
   pOstream << DELIM_VAR_SEPARATOR << fOrigin;
@@ -38,3 +46,11 @@ void RangeUpdateMessage::Deserialise(istream& pIstream) {
   pIstream >> fRange;
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
+
+void RangeUpdateMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fRange;
+}
+
+void RangeUpdateMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fRange;
+}
@@ -44,3 +44,11 @@ void RollbackMessage::Deserialise(istream& pIstream) {
   pIstream >> original_agent_;
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
+
+void RollbackMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fRollbackTag << original_agent_;
+}
+
+void RollbackMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fRollbackTag >> original_agent_;
+}
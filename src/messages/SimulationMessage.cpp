@@ -19,3 +19,23 @@ void SimulationMessage::SendToLp(Lp *pLp) const {
 void SimulationMessage::ReceiveToLp(Lp *pLp) const {
   pLp->fReceiveMessageQueue->QueueMessage((AbstractMessage*) this);
 }
+
+MessageLane SimulationMessage::GetLane() const {
+  return SIMULATION_LANE;
+}
+
+unsigned long SimulationMessage::GetWireTimestamp() const {
+  return fTimestamp;
+}
+
+void SimulationMessage::SetWireTimestamp(unsigned long pTimestamp) {
+  fTimestamp = pTimestamp;
+}
+
+MatternColour SimulationMessage::GetWireColour() const {
+  return fMatternColour;
+}
+
+void SimulationMessage::SetWireColour(MatternColour pMatternColour) {
+  fMatternColour = pMatternColour;
+}
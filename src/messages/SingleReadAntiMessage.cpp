@@ -50,3 +50,11 @@ void SingleReadAntiMessage::Deserialise(istream& pIstream) {
   pIstream >> fSsvId;
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
+
+void SingleReadAntiMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fNumberOfHops << fRollbackTag << original_agent_ << fSsvId;
+}
+
+void SingleReadAntiMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fNumberOfHops >> fRollbackTag >> original_agent_ >> fSsvId;
+}
@@ -50,3 +50,11 @@ void SingleReadMessage::Deserialise(istream& pIstream) {
   pIstream >> fSsvId;
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
+
+void SingleReadMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fNumberOfHops << fIdentifier << original_agent_ << fSsvId;
+}
+
+void SingleReadMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fNumberOfHops >> fIdentifier >> original_agent_ >> fSsvId;
+}
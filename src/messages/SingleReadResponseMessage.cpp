@@ -49,7 +49,18 @@ void SingleReadResponseMessage::Deserialise(istream& pIstream) {
   string valueString;
   pIstream >> valueString;
   string value = GetValueString(valueString);
-  fValue = valueClassMap->CreateObject(GetTypeID(valueString));
-  fValue->SetValue(value);
+  AbstractValue* newValue = valueClassMap->CreateObject(GetTypeID(valueString));
+  newValue->SetValue(value);
+  fValue.reset(newValue);
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
+
+void SingleReadResponseMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fIdentifier << original_agent_;
+  PackValue(pWriter, fValue.get());
+}
+
+void SingleReadResponseMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fIdentifier >> original_agent_;
+  fValue.reset(UnpackValue(pReader));
+}
@@ -35,3 +35,11 @@ void StateMigrationMessage::Deserialise(istream& pIstream) {
   pIstream >> fStateVariableMap;
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
+
+void StateMigrationMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fStateVariableMap;
+}
+
+void StateMigrationMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fStateVariableMap;
+}
@@ -50,3 +50,11 @@ void WriteAntiMessage::Deserialise(istream& pIstream) {
   pIstream >> fSsvId;
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
+
+void WriteAntiMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fNumberOfHops << fRollbackTag << original_agent_ << fSsvId;
+}
+
+void WriteAntiMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fNumberOfHops >> fRollbackTag >> original_agent_ >> fSsvId;
+}
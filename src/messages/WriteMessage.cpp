@@ -54,7 +54,18 @@ void WriteMessage::Deserialise(istream& pIstream) {
   string valueString;
   pIstream >> valueString;
   string value = GetValueString(valueString);
-  fValue = valueClassMap->CreateObject(GetTypeID(valueString));
-  fValue->SetValue(value);
+  AbstractValue* newValue = valueClassMap->CreateObject(GetTypeID(valueString));
+  newValue->SetValue(value);
+  fValue.reset(newValue);
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
+
+void WriteMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fNumberOfHops << fIdentifier << original_agent_ << fSsvId;
+  PackValue(pWriter, fValue.get());
+}
+
+void WriteMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fNumberOfHops >> fIdentifier >> original_agent_ >> fSsvId;
+  fValue.reset(UnpackValue(pReader));
+}
@@ -48,3 +48,11 @@ void WriteResponseMessage::Deserialise(istream& pIstream) {
   pIstream >> fWriteStatus;
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
+
+void WriteResponseMessage::PackPayload(WireWriter& pWriter) const {
+  pWriter << fIdentifier << original_agent_ << fWriteStatus;
+}
+
+void WriteResponseMessage::UnpackPayload(WireReader& pReader) {
+  pReader >> fIdentifier >> original_agent_ >> fWriteStatus;
+}
@@ -71,6 +71,36 @@ void HasAgentTimeHistoryRecord::AgentTimeHistoryRecord::Deserialise(istream &pIs
   }
 }
 
+void HasAgentTimeHistoryRecord::AgentTimeHistoryRecord::Pack(WireWriter &pWriter) const {
+  const unsigned int mapSize = agentTimeHistoryRecord.size();
+  pWriter << mapSize;
+  for (const auto &i:agentTimeHistoryRecord) {
+    const unsigned int size = i.second.size();
+    pWriter << i.first << size;
+    for (unsigned long time:i.second) {
+      pWriter << time;
+    }
+  }
+}
+
+void HasAgentTimeHistoryRecord::AgentTimeHistoryRecord::Unpack(WireReader &pReader) {
+  this->agentTimeHistoryRecord = map<unsigned long, list<unsigned long>>();
+  unsigned int mapSize;
+  pReader >> mapSize;
+  for (unsigned int i = 0; i < mapSize && pReader.IsGood(); ++i) {
+    unsigned long agentId;
+    unsigned int size;
+    pReader >> agentId >> size;
+    list<unsigned long> history;
+    for (unsigned int counter = 0; counter < size && pReader.IsGood(); ++counter) {
+      unsigned long theValue;
+      pReader >> theValue;
+      history.push_back(theValue);
+    }
+    this->agentTimeHistoryRecord.insert(make_pair(agentId, history));
+  }
+}
+
 map<unsigned long, list<unsigned long>>
 HasAgentTimeHistoryRecord::AgentTimeHistoryRecord::GetAgentTimeHistoryRecord() const {
   return this->agentTimeHistoryRecord;
@@ -0,0 +1,21 @@
+/*
+ * HasSSVIDList.cpp
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#include "HasSSVIDList.h"
+
+using namespace pdesmas;
+
+const SerialisableList<SsvId>& HasSSVIDList::GetSsvIdList() const {
+  return fSsvIdList;
+}
+
+void HasSSVIDList::SetSsvIdList(const SerialisableList<SsvId>& pSsvIdList) {
+  fSsvIdList = pSsvIdList;
+}
+
+void HasSSVIDList::AddSsvId(const SsvId& pSsvId) {
+  fSsvIdList.push_back(pSsvId);
+}
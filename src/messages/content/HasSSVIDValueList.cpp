@@ -0,0 +1,74 @@
+/*
+ * HasSSVIDValueList.cpp
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#include <limits>
+#include "HasSSVIDValueList.h"
+#include "ObjectMgr.h"
+
+using namespace std;
+using namespace pdesmas;
+
+const SsvIdValueList& HasSSVIDValueList::GetSsvIdValueList() const {
+  return fSsvIdValueList;
+}
+
+void HasSSVIDValueList::AddSsvIdValue(const SsvId& pSsvId, AbstractValue* pValue) {
+  fSsvIdValueList.push_back(make_pair(pSsvId, shared_ptr<const AbstractValue>(pValue)));
+}
+
+void HasSSVIDValueList::AddSsvIdValue(const SsvId& pSsvId, const shared_ptr<const AbstractValue>& pValue) {
+  fSsvIdValueList.push_back(make_pair(pSsvId, pValue));
+}
+
+void HasSSVIDValueList::ClearSsvIdValueList() {
+  fSsvIdValueList.clear();
+}
+
+void HasSSVIDValueList::SerialiseSsvIdValueList(ostream& pOstream) const {
+  const unsigned int size = fSsvIdValueList.size();
+  pOstream << size;
+  for (SsvIdValueList::const_iterator iter = fSsvIdValueList.begin(); iter != fSsvIdValueList.end(); ++iter) {
+    pOstream << DELIM_LIST_LEFT << iter->first << DELIM_LIST_LEFT << *iter->second << DELIM_LIST_RIGHT;
+  }
+}
+
+void HasSSVIDValueList::DeserialiseSsvIdValueList(istream& pIstream) {
+  fSsvIdValueList.clear();
+  unsigned int size;
+  pIstream >> size;
+  for (unsigned int counter = 0; counter < size; ++counter) {
+    pIstream.ignore(numeric_limits<streamsize>::max(), DELIM_LIST_LEFT);
+    SsvId ssvId;
+    pIstream >> ssvId;
+    pIstream.ignore(numeric_limits<streamsize>::max(), DELIM_LIST_LEFT);
+    // The value is read whole, as WritePeriod reads its value
+    string valueString;
+    getline(pIstream, valueString, DELIM_LIST_RIGHT);
+    AbstractValue* value = valueClassMap->CreateObject(GetTypeID(valueString));
+    value->SetValue(GetValueString(valueString));
+    AddSsvIdValue(ssvId, value);
+  }
+}
+
+void HasSSVIDValueList::PackSsvIdValueList(WireWriter& pWriter) const {
+  const unsigned int size = fSsvIdValueList.size();
+  pWriter << size;
+  for (SsvIdValueList::const_iterator iter = fSsvIdValueList.begin(); iter != fSsvIdValueList.end(); ++iter) {
+    pWriter << iter->first;
+    PackValue(pWriter, iter->second.get());
+  }
+}
+
+void HasSSVIDValueList::UnpackSsvIdValueList(WireReader& pReader) {
+  fSsvIdValueList.clear();
+  unsigned int size;
+  pReader >> size;
+  for (unsigned int counter = 0; counter < size && pReader.IsGood(); ++counter) {
+    SsvId ssvId;
+    pReader >> ssvId;
+    AddSsvIdValue(ssvId, UnpackValue(pReader));
+  }
+}
@@ -0,0 +1,17 @@
+/*
+ * HasSSVIDWriteStatusMap.cpp
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#include "HasSSVIDWriteStatusMap.h"
+
+using namespace pdesmas;
+
+const SerialisableMap<SsvId, WriteStatus>& HasSSVIDWriteStatusMap::GetSsvIdWriteStatusMap() const {
+  return fSsvIdWriteStatusMap;
+}
+
+void HasSSVIDWriteStatusMap::SetSsvIdWriteStatus(const SsvId& pSsvId, WriteStatus pWriteStatus) {
+  fSsvIdWriteStatusMap[pSsvId] = pWriteStatus;
+}
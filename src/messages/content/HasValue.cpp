@@ -10,16 +10,21 @@
 using namespace pdesmas;
 
 const AbstractValue* HasValue::GetValue() const {
+  return fValue.get();
+}
+
+const std::shared_ptr<const AbstractValue>& HasValue::GetSharedValue() const {
   return fValue;
 }
 
 void HasValue::SetValue(AbstractValue* pValue) {
+  fValue.reset(pValue);
+}
+
+void HasValue::SetValue(const std::shared_ptr<const AbstractValue>& pValue) {
   fValue = pValue;
 }
 
 void HasValue::ClearValue() {
-  if (NULL != fValue) {
-    delete fValue;
-    fValue = NULL;
-  }
+  fValue.reset();
 }
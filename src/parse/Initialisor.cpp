@@ -15,6 +15,8 @@
 #include "RangeQueryAntiMessage.h"
 #include "WriteMessage.h"
 #include "WriteResponseMessage.h"
+#include "MultiReadResponseMessage.h"
+#include "MultiWriteResponseMessage.h"
 #include "WriteAntiMessage.h"
 #include "GvtControlMessage.h"
 #include "GvtRequestMessage.h"
@@ -144,6 +146,10 @@ void Initialisor::InitEverything() {
   WriteMessage();
   WriteResponseMessage();
   WriteAntiMessage();
+  MultiReadMessage();
+  MultiReadResponseMessage();
+  MultiWriteMessage();
+  MultiWriteResponseMessage();
   GvtControlMessage();
   GvtRequestMessage();
   GvtValueMessage();
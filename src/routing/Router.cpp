@@ -87,6 +87,20 @@ bool Router::Route(WriteResponseMessage* pWriteResponseMessage) {
   return false;
 }
 
+bool Router::Route(MultiReadResponseMessage* pMultiReadResponseMessage) {
+  Direction direction = fRouteTable.GetDirectionFromRank(pMultiReadResponseMessage->GetOriginalAgent().GetRank());
+  if (direction == HERE) return true;
+  pMultiReadResponseMessage->SetDestination(fRouteTable.GetRankFromDirection(direction));
+  return false;
+}
+
+bool Router::Route(MultiWriteResponseMessage* pMultiWriteResponseMessage) {
+  Direction direction = fRouteTable.GetDirectionFromRank(pMultiWriteResponseMessage->GetOriginalAgent().GetRank());
+  if (direction == HERE) return true;
+  pMultiWriteResponseMessage->SetDestination(fRouteTable.GetRankFromDirection(direction));
+  return false;
+}
+
 unsigned int Router::GetLpRankByDirection(Direction pDirection) const {
   return fRouteTable.GetRankFromDirection(pDirection);
 }
@@ -95,6 +109,15 @@ Direction Router::GetDirectionByLpRank(unsigned int pLpRank) const {
   return fRouteTable.GetDirectionFromRank(pLpRank);
 }
 
+Direction Router::GetDirectionBySsvId(const SsvId& pSsvId) const {
+  Direction direction = fRouteTable.GetDirectionFromSsvId(pSsvId);
+  if (direction == DIRECTION_SIZE) {
+    LOG(logERROR) << "Router::GetDirectionBySsvId# Could not find direction from SSVID: " << pSsvId;
+    exit(1);
+  }
+  return direction;
+}
+
 void Router::SetSsvIdDirection(SsvId SsvID, Direction pDirection) {
   fRouteTable.SetSsvIdHost(SsvID, pDirection);
 }
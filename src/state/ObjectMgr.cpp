@@ -1,4 +1,5 @@
 #include "ObjectMgr.h"
+#include "spdlog/spdlog.h"
 
 using namespace std;
 
@@ -22,4 +23,19 @@ namespace pdesmas {
     return (msgString.substr(start, end - start));
   }
 
+  void PackValue(WireWriter& pWriter, const AbstractValue* pValue) {
+    pValue->Pack(pWriter);
+  }
+
+  AbstractValue* UnpackValue(WireReader& pReader) {
+    unsigned char type;
+    if (!pReader.PeekAt(pReader.GetPosition(), &type, sizeof(type))) {
+      spdlog::critical("UnpackValue# Buffer ends before value type");
+      exit(1);
+    }
+    AbstractValue* value = valueClassMap->CreateObject(static_cast<pdesmasType>(type));
+    value->Unpack(pReader);
+    return value;
+  }
+
 }
@@ -0,0 +1,85 @@
+#include "PointBounds.h"
+#include <climits>
+#include <cstdlib>
+#include "spdlog/spdlog.h"
+
+using namespace std;
+using namespace pdesmas;
+
+bool PointBounds::IsUnbounded(const Point& pPoint) {
+  return pPoint.GetX() == INT_MAX && pPoint.GetY() == INT_MAX;
+}
+
+void PointBounds::AddPoint(Bounds& pBounds, const Point& pPoint) {
+  if (IsUnbounded(pPoint)) {
+    ++pBounds.fUnboundedCount;
+    return;
+  }
+  pBounds.fX.insert(pPoint.GetX());
+  pBounds.fY.insert(pPoint.GetY());
+}
+
+void PointBounds::RemovePoint(Bounds& pBounds, const Point& pPoint) {
+  if (IsUnbounded(pPoint)) {
+    if (pBounds.fUnboundedCount == 0) {
+      spdlog::critical("PointBounds::RemovePoint# No unbounded point to remove");
+      exit(1);
+    }
+    --pBounds.fUnboundedCount;
+    return;
+  }
+  multiset<int>::iterator xIterator = pBounds.fX.find(pPoint.GetX());
+  multiset<int>::iterator yIterator = pBounds.fY.find(pPoint.GetY());
+  if (xIterator == pBounds.fX.end() || yIterator == pBounds.fY.end()) {
+    spdlog::critical("PointBounds::RemovePoint# Point ({},{}) is not in the bounds", pPoint.GetX(), pPoint.GetY());
+    exit(1);
+  }
+  pBounds.fX.erase(xIterator);
+  pBounds.fY.erase(yIterator);
+}
+
+void PointBounds::Replace(const Point* pOldPoint, const Point* pNewPoint, unsigned long pStartTime,
+                          unsigned long pEndTime) {
+  if ((pOldPoint == NULL && pNewPoint == NULL) || pStartTime >= pEndTime) return;
+  map<unsigned long, Bounds>::iterator boundsIterator = fBoundsByTime.lower_bound(pStartTime);
+  if (boundsIterator == fBoundsByTime.end() || boundsIterator->first != pStartTime) {
+    // The bounds change from here, start from the bounds of the time before
+    Bounds bounds;
+    if (boundsIterator != fBoundsByTime.begin()) {
+      map<unsigned long, Bounds>::iterator previousIterator = boundsIterator;
+      bounds = (--previousIterator)->second;
+    }
+    boundsIterator = fBoundsByTime.insert(boundsIterator, make_pair(pStartTime, bounds));
+  }
+  for (; boundsIterator != fBoundsByTime.end() && boundsIterator->first < pEndTime; ++boundsIterator) {
+    if (pOldPoint) RemovePoint(boundsIterator->second, *pOldPoint);
+    if (pNewPoint) AddPoint(boundsIterator->second, *pNewPoint);
+  }
+}
+
+void PointBounds::RemoveBefore(unsigned long pTime) {
+  map<unsigned long, Bounds>::iterator boundsIterator = fBoundsByTime.upper_bound(pTime);
+  if (boundsIterator == fBoundsByTime.begin()) return;
+  // Keep the bounds in force at the time, moved to the time itself
+  --boundsIterator;
+  if (boundsIterator->first != pTime) {
+    map<unsigned long, Bounds>::iterator keptIterator = fBoundsByTime.insert(boundsIterator,
+                                                                             make_pair(pTime, Bounds()));
+    keptIterator->second.fX.swap(boundsIterator->second.fX);
+    keptIterator->second.fY.swap(boundsIterator->second.fY);
+    keptIterator->second.fUnboundedCount = boundsIterator->second.fUnboundedCount;
+    boundsIterator = keptIterator;
+  }
+  fBoundsByTime.erase(fBoundsByTime.begin(), boundsIterator);
+}
+
+Range* PointBounds::GetRange(unsigned long pTime) const {
+  map<unsigned long, Bounds>::const_iterator boundsIterator = fBoundsByTime.upper_bound(pTime);
+  if (boundsIterator == fBoundsByTime.begin()) return NULL;
+  const Bounds& bounds = (--boundsIterator)->second;
+  if (bounds.fX.empty()) {
+    if (bounds.fUnboundedCount == 0) return NULL;
+    return new Range(Point(INT_MAX, INT_MAX), Point(INT_MAX, INT_MAX));
+  }
+  return new Range(Point(*bounds.fX.begin(), *bounds.fY.begin()), Point(*bounds.fX.rbegin(), *bounds.fY.rbegin()));
+}
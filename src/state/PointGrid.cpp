@@ -0,0 +1,79 @@
+#include "PointGrid.h"
+#include <algorithm>
+#include <cstdlib>
+#include "spdlog/spdlog.h"
+
+using namespace std;
+using namespace pdesmas;
+
+int PointGrid::GetCellCoordinate(int pCoordinate) {
+  // Round down, also for negative coordinates
+  long coordinate = pCoordinate;
+  if (coordinate >= 0) return (int) (coordinate / POINT_GRID_CELL_SIZE);
+  return (int) (-((-coordinate - 1) / POINT_GRID_CELL_SIZE) - 1);
+}
+
+unsigned long PointGrid::GetCellKey(int pCellX, int pCellY) {
+  return ((unsigned long) (unsigned int) pCellX << 32) | (unsigned int) pCellY;
+}
+
+void PointGrid::Add(unsigned long pSsvId, const Point& pPoint) {
+  int cellX = GetCellCoordinate(pPoint.GetX());
+  int cellY = GetCellCoordinate(pPoint.GetY());
+  pair<Cell*, bool> insertResult = fCells.Insert(GetCellKey(cellX, cellY));
+  if (insertResult.second) {
+    insertResult.first->fX = cellX;
+    insertResult.first->fY = cellY;
+  }
+  ++insertResult.first->fVersionCounts[pSsvId];
+}
+
+void PointGrid::Remove(unsigned long pSsvId, const Point& pPoint) {
+  unsigned long cellKey = GetCellKey(GetCellCoordinate(pPoint.GetX()), GetCellCoordinate(pPoint.GetY()));
+  Cell* cell = fCells.Find(cellKey);
+  map<unsigned long, unsigned int>::iterator versionCountIterator;
+  if (cell == NULL || (versionCountIterator = cell->fVersionCounts.find(pSsvId)) == cell->fVersionCounts.end()) {
+    spdlog::critical("PointGrid::Remove# SSV {} is not in the cell of ({},{})", pSsvId, pPoint.GetX(),
+                     pPoint.GetY());
+    exit(1);
+  }
+  if (--versionCountIterator->second == 0) {
+    cell->fVersionCounts.erase(versionCountIterator);
+    if (cell->fVersionCounts.empty()) fCells.Erase(cellKey);
+  }
+}
+
+void PointGrid::FindCandidates(const Range& pRange, vector<unsigned long>& pSsvIds) const {
+  int minimumCellX = GetCellCoordinate(pRange.GetMinRangeValue().GetX());
+  int minimumCellY = GetCellCoordinate(pRange.GetMinRangeValue().GetY());
+  int maximumCellX = GetCellCoordinate(pRange.GetMaxRangeValue().GetX());
+  int maximumCellY = GetCellCoordinate(pRange.GetMaxRangeValue().GetY());
+  if (maximumCellX < minimumCellX || maximumCellY < minimumCellY) return;
+  size_t firstCandidate = pSsvIds.size();
+  long rangeCellCount = ((long) maximumCellX - minimumCellX + 1) * ((long) maximumCellY - minimumCellY + 1);
+  if ((unsigned long) rangeCellCount <= fCells.Size()) {
+    // Look up the cells of the range
+    for (int cellX = minimumCellX; cellX <= maximumCellX; ++cellX) {
+      for (int cellY = minimumCellY; cellY <= maximumCellY; ++cellY) {
+        const Cell* cell = fCells.Find(GetCellKey(cellX, cellY));
+        if (cell == NULL) continue;
+        for (const pair<const unsigned long, unsigned int>& versionCount : cell->fVersionCounts) {
+          pSsvIds.push_back(versionCount.first);
+        }
+      }
+    }
+  } else {
+    // The range spans more cells than are in use, walk the used ones instead
+    for (const Cell& cell : fCells) {
+      if (cell.fX < minimumCellX || cell.fX > maximumCellX || cell.fY < minimumCellY || cell.fY > maximumCellY) {
+        continue;
+      }
+      for (const pair<const unsigned long, unsigned int>& versionCount : cell.fVersionCounts) {
+        pSsvIds.push_back(versionCount.first);
+      }
+    }
+  }
+  // Variables that moved have write periods in several cells
+  sort(pSsvIds.begin() + firstCandidate, pSsvIds.end());
+  pSsvIds.erase(unique(pSsvIds.begin() + firstCandidate, pSsvIds.end()), pSsvIds.end());
+}
@@ -0,0 +1,163 @@
+#include "ReadRecordList.h"
+#include <algorithm>
+
+using namespace std;
+using namespace pdesmas;
+
+bool ReadRecordList::HasFirstTimeBefore(const ReadRecordList::ReadRecord& pReadRecord, unsigned long pTime) {
+  return pReadRecord.fFirstTime < pTime;
+}
+
+bool ReadRecordList::IsBeforeFirstTime(unsigned long pTime, const ReadRecordList::ReadRecord& pReadRecord) {
+  return pTime < pReadRecord.fFirstTime;
+}
+
+vector<ReadRecordList::ReadRecord>::iterator ReadRecordList::FindAgent(const LpId& pAgent) {
+  vector<ReadRecord>::iterator readRecordIterator = fReadRecords.begin();
+  while (readRecordIterator != fReadRecords.end() && readRecordIterator->fAgent != pAgent) ++readRecordIterator;
+  return readRecordIterator;
+}
+
+vector<ReadRecordList::ReadRecord>::iterator ReadRecordList::FindFirstAtOrAfter(unsigned long pTime) {
+  return lower_bound(fReadRecords.begin(), fReadRecords.end(), pTime, HasFirstTimeBefore);
+}
+
+void ReadRecordList::Add(const LpId& pAgent, unsigned long pFirstTime, unsigned long pLastTime) {
+  vector<ReadRecord>::iterator readRecordIterator = FindAgent(pAgent);
+  if (readRecordIterator != fReadRecords.end()) {
+    if (readRecordIterator->fFirstTime <= pFirstTime) {
+      // The record keeps its place in the order
+      readRecordIterator->fLastTime = max(readRecordIterator->fLastTime, pLastTime);
+      return;
+    }
+    pLastTime = max(readRecordIterator->fLastTime, pLastTime);
+    fReadRecords.erase(readRecordIterator);
+  }
+  ReadRecord readRecord = {pAgent, pFirstTime, pLastTime};
+  fReadRecords.insert(upper_bound(fReadRecords.begin(), fReadRecords.end(), pFirstTime, IsBeforeFirstTime),
+                      readRecord);
+}
+
+void ReadRecordList::Add(const LpId& pAgent, unsigned long pTime) {
+  Add(pAgent, pTime, pTime);
+}
+
+void ReadRecordList::RemoveBefore(unsigned long pTime) {
+  vector<ReadRecord>::iterator afterIterator = FindFirstAtOrAfter(pTime);
+  // Records starting before the time either end before it too, or keep their reads from the time on
+  vector<ReadRecord>::iterator keptIterator = fReadRecords.begin();
+  for (vector<ReadRecord>::iterator readRecordIterator = fReadRecords.begin(); readRecordIterator != afterIterator;
+       ++readRecordIterator) {
+    if (readRecordIterator->fLastTime < pTime) continue;
+    *keptIterator = *readRecordIterator;
+    keptIterator->fFirstTime = pTime;
+    ++keptIterator;
+  }
+  fReadRecords.erase(keptIterator, afterIterator);
+}
+
+void ReadRecordList::RemoveAfterInclusive(unsigned long pTime, RollbackList& pRollbackList) {
+  vector<ReadRecord>::iterator afterIterator = FindFirstAtOrAfter(pTime);
+  for (vector<ReadRecord>::iterator readRecordIterator = fReadRecords.begin(); readRecordIterator != afterIterator;
+       ++readRecordIterator) {
+    if (readRecordIterator->fLastTime < pTime) continue;
+    pRollbackList.AddLp(readRecordIterator->fAgent, pTime);
+    readRecordIterator->fLastTime = pTime - 1;
+  }
+  for (vector<ReadRecord>::iterator readRecordIterator = afterIterator; readRecordIterator != fReadRecords.end();
+       ++readRecordIterator) {
+    pRollbackList.AddLp(readRecordIterator->fAgent, readRecordIterator->fFirstTime);
+  }
+  fReadRecords.erase(afterIterator, fReadRecords.end());
+}
+
+void ReadRecordList::RemoveByAgent(const LpId& pAgent, unsigned long pTime) {
+  vector<ReadRecord>::iterator readRecordIterator = FindAgent(pAgent);
+  if (readRecordIterator == fReadRecords.end()) return;
+  if (pTime <= readRecordIterator->fFirstTime) {
+    fReadRecords.erase(readRecordIterator);
+    return;
+  }
+  readRecordIterator->fLastTime = min(readRecordIterator->fLastTime, pTime - 1);
+}
+
+void ReadRecordList::RemoveAll(unsigned long pTime, RollbackList& pRollbackList) {
+  for (const ReadRecord& readRecord : fReadRecords) {
+    pRollbackList.AddLp(readRecord.fAgent, pTime);
+  }
+  fReadRecords.clear();
+}
+
+unsigned long ReadRecordList::MoveAfterInclusive(unsigned long pTime, ReadRecordList& pReadRecordList) {
+  unsigned long movedCount = 0;
+  vector<ReadRecord>::iterator afterIterator = FindFirstAtOrAfter(pTime);
+  for (vector<ReadRecord>::iterator readRecordIterator = fReadRecords.begin(); readRecordIterator != afterIterator;
+       ++readRecordIterator) {
+    if (readRecordIterator->fLastTime < pTime) continue;
+    pReadRecordList.Add(readRecordIterator->fAgent, pTime, readRecordIterator->fLastTime);
+    readRecordIterator->fLastTime = pTime - 1;
+    ++movedCount;
+  }
+  for (vector<ReadRecord>::iterator readRecordIterator = afterIterator; readRecordIterator != fReadRecords.end();
+       ++readRecordIterator) {
+    pReadRecordList.Add(readRecordIterator->fAgent, readRecordIterator->fFirstTime, readRecordIterator->fLastTime);
+    ++movedCount;
+  }
+  fReadRecords.erase(afterIterator, fReadRecords.end());
+  return movedCount;
+}
+
+unsigned long ReadRecordList::MoveAll(ReadRecordList& pReadRecordList) {
+  unsigned long movedCount = fReadRecords.size();
+  for (const ReadRecord& readRecord : fReadRecords) {
+    pReadRecordList.Add(readRecord.fAgent, readRecord.fFirstTime, readRecord.fLastTime);
+  }
+  fReadRecords.clear();
+  return movedCount;
+}
+
+void ReadRecordList::Swap(ReadRecordList& pReadRecordList) {
+  fReadRecords.swap(pReadRecordList.fReadRecords);
+}
+
+void ReadRecordList::Serialise(ostream& pOstream) const {
+  pOstream << fReadRecords.size();
+  for (const ReadRecord& readRecord : fReadRecords) {
+    pOstream << DELIM_LIST_LEFT << readRecord.fAgent << DELIM_VAR_SEPARATOR << readRecord.fFirstTime
+             << DELIM_VAR_SEPARATOR << readRecord.fLastTime << DELIM_LIST_RIGHT;
+  }
+}
+
+void ReadRecordList::Deserialise(istream& pIstream) {
+  fReadRecords.clear();
+  size_t size;
+  pIstream >> size;
+  fReadRecords.resize(size);
+  for (ReadRecord& readRecord : fReadRecords) {
+    IgnoreTo(pIstream, DELIM_LIST_LEFT);
+    pIstream >> readRecord.fAgent;
+    IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+    pIstream >> readRecord.fFirstTime;
+    IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
+    pIstream >> readRecord.fLastTime;
+    IgnoreTo(pIstream, DELIM_LIST_RIGHT);
+  }
+}
+
+void ReadRecordList::Pack(WireWriter& pWriter) const {
+  pWriter << static_cast<unsigned int>(fReadRecords.size());
+  for (const ReadRecord& readRecord : fReadRecords) {
+    pWriter << readRecord.fAgent << readRecord.fFirstTime << readRecord.fLastTime;
+  }
+}
+
+void ReadRecordList::Unpack(WireReader& pReader) {
+  fReadRecords.clear();
+  unsigned int size;
+  pReader >> size;
+  for (unsigned int counter = 0; counter < size && pReader.IsGood(); ++counter) {
+    ReadRecord readRecord;
+    pReader >> readRecord.fAgent >> readRecord.fFirstTime >> readRecord.fLastTime;
+    fReadRecords.push_back(readRecord);
+  }
+}
@@ -5,6 +5,13 @@ using namespace pdesmas;
 SharedState::SharedState() {
   fRangeRoutingTable = NULL;
   fAccessCostCalculator = NULL;
+  fValueSize = 0;
+  fVersionCount = 0;
+  fKeptReadCount = 0;
+  fShardMutex = NULL;
+#ifdef RANGE_QUERIES
+  fPointBounds = &fOwnPointBounds;
+#endif
 }
 
 SharedState::~SharedState() {
@@ -19,26 +26,105 @@ void SharedState::SetAccessCostCalculator(AccessCostCalculator *pAccessCostCalcu
   fAccessCostCalculator = pAccessCostCalculator;
 }
 
+void SharedState::ShareWithShards(PointBounds *pPointBounds, Mutex *pShardMutex) {
+#ifdef RANGE_QUERIES
+  fPointBounds = pPointBounds;
+#endif
+  fShardMutex = pShardMutex;
+}
+
+void SharedState::AddToTotals(const StateVariable &pStateVariable) {
+  fValueSize += pStateVariable.GetValueSize();
+  fVersionCount += pStateVariable.GetVersionCount();
+}
+
+void SharedState::RemoveFromTotals(const StateVariable &pStateVariable) {
+  fValueSize -= pStateVariable.GetValueSize();
+  fVersionCount -= pStateVariable.GetVersionCount();
+}
+
+#ifdef RANGE_QUERIES
+void SharedState::AddPoints(const StateVariable &pStateVariable) {
+  const SerialisableDeque<WritePeriod> &writePeriodList = pStateVariable.GetWritePeriodList();
+  for (size_t index = 0; index < writePeriodList.size(); ++index) {
+    const StoredValue &value = writePeriodList[index].GetValue();
+    if (VALUEPOINT != value.GetType() || value.IsEmpty()) continue;
+    Point point = value.GetPoint();
+    fPointGrid.Add(pStateVariable.GetVariableId().id(), point);
+    unsigned long endTime = (index + 1 < writePeriodList.size()) ? writePeriodList[index + 1].GetStartTime()
+                                                                 : ULONG_MAX;
+    fPointBounds->Replace(NULL, &point, writePeriodList[index].GetStartTime(), endTime);
+  }
+}
+
+void SharedState::RemovePoints(const StateVariable &pStateVariable) {
+  const SerialisableDeque<WritePeriod> &writePeriodList = pStateVariable.GetWritePeriodList();
+  for (size_t index = 0; index < writePeriodList.size(); ++index) {
+    const StoredValue &value = writePeriodList[index].GetValue();
+    if (VALUEPOINT != value.GetType() || value.IsEmpty()) continue;
+    Point point = value.GetPoint();
+    fPointGrid.Remove(pStateVariable.GetVariableId().id(), point);
+    unsigned long endTime = (index + 1 < writePeriodList.size()) ? writePeriodList[index + 1].GetStartTime()
+                                                                 : ULONG_MAX;
+    fPointBounds->Replace(&point, NULL, writePeriodList[index].GetStartTime(), endTime);
+  }
+}
+
+Point *SharedState::GetPointStartingAt(const StateVariable &pStateVariable, unsigned long pTime) const {
+  const WritePeriod *writePeriod = pStateVariable.FindWritePeriodStartingAt(pTime);
+  if (writePeriod == NULL || VALUEPOINT != writePeriod->GetValue().GetType() || writePeriod->GetValue().IsEmpty()) {
+    return NULL;
+  }
+  return new Point(writePeriod->GetValue().GetPoint());
+}
+
+void SharedState::RemoveFromPointGridBefore(const StateVariable &pStateVariable, unsigned long pTime) {
+  // The write periods StateVariable::RemoveWritePeriods erases, those followed by one starting at or before the time
+  const SerialisableDeque<WritePeriod> &writePeriodList = pStateVariable.GetWritePeriodList();
+  for (size_t index = 0; index + 1 < writePeriodList.size() && writePeriodList[index + 1].GetStartTime() <= pTime;
+       ++index) {
+    const StoredValue &value = writePeriodList[index].GetValue();
+    if (VALUEPOINT == value.GetType() && !value.IsEmpty()) {
+      fPointGrid.Remove(pStateVariable.GetVariableId().id(), value.GetPoint());
+    }
+  }
+}
+#endif
+
+unsigned long SharedState::GetValueSize() const {
+  return fValueSize;
+}
+
+unsigned long SharedState::GetVersionCount() const {
+  return fVersionCount;
+}
+
+unsigned long SharedState::GetKeptReadCount() const {
+  return fKeptReadCount;
+}
+
 void SharedState::UpdateAccessCount(const SsvId &pSSVID, Direction pDirection, unsigned long pNumberOfHops) {
   unsigned long access, hops;
+  if (fShardMutex) fShardMutex->Lock();
   access = fAccessCostCalculator->UpdateAccessCount(pDirection, 1, pSSVID);
   hops = fAccessCostCalculator->UpdateHopCount(pDirection, pNumberOfHops, pSSVID);
   fAccessCostCalculator->UpdateLoad(hops, access, pNumberOfHops + hops, access + 1);
-}
-
-bool SharedState::ContainsVariable(const SsvId &pSSVID) {
-  return (fStateVariableMap.count(pSSVID) > 0);
+  if (fShardMutex) fShardMutex->Unlock();
 }
 
 void SharedState::Add(const SsvId &pSSVID, const AbstractValue *pValue, unsigned long pTime, const LpId &pAgentID) {
-  if (ContainsVariable(pSSVID)) {
+  pair<StateVariable *, bool> insertResult = fStateVariableMap.Insert(pSSVID.id());
+  if (!insertResult.second) {
     LOG(logERROR)
       << "SharedState::Add(SsvID,AbstractValue*,unsigned long,LpId)# trying to add a variable that already exists";
     exit(1);
   }
-  StateVariable newStateVariable(pSSVID);
-  newStateVariable.AddWritePeriod(pValue, pTime, pAgentID);
-  fStateVariableMap[pSSVID] = newStateVariable;
+  *insertResult.first = StateVariable(pSSVID);
+  insertResult.first->AddWritePeriod(pValue, pTime, pAgentID);
+  AddToTotals(*insertResult.first);
+#ifdef RANGE_QUERIES
+  AddPoints(*insertResult.first);
+#endif
 
 #ifdef SSV_LOCALISATION
   fAccessCostCalculator->InitialiseCounters(pSSVID);
@@ -46,40 +132,45 @@ void SharedState::Add(const SsvId &pSSVID, const AbstractValue *pValue, unsigned
 }
 
 void SharedState::Insert(const SsvId &pSSVID, const StateVariable &pStateVariable, RollbackList &pRollbackList) {
-  if (ContainsVariable(pSSVID)) {
+  pair<StateVariable *, bool> insertResult = fStateVariableMap.Insert(pSSVID.id());
+  if (!insertResult.second) {
     LOG(logERROR) << "SharedState::Insert# Trying to insert a shared state variable that already exists!";
     exit(1);
   }
-  fStateVariableMap[pSSVID] = StateVariable(pSSVID);
-  map<SsvId, StateVariable>::iterator stateVariableMapIterator = fStateVariableMap.find(pSSVID);
-  SerialisableList<WritePeriod> writePeriodList = pStateVariable.GetWritePeriodList();
-  list<WritePeriod>::iterator writePeriodListIterator = writePeriodList.begin();
+  StateVariable *stateVariable = insertResult.first;
+  *stateVariable = StateVariable(pSSVID);
+  SerialisableDeque<WritePeriod> writePeriodList = pStateVariable.GetWritePeriodList();
+  deque<WritePeriod>::iterator writePeriodListIterator = writePeriodList.begin();
 
   while (writePeriodListIterator != writePeriodList.end()) {
 #ifdef RANGE_QUERIES
-    pair<unsigned long, AbstractValue *> timeValuePair = stateVariableMapIterator->second.ReadWithoutRecord(
+    pair<unsigned long, const StoredValue *> timeValuePair = stateVariable->ReadWithoutRecord(
         writePeriodListIterator->GetStartTime());
     Point *oldValue = NULL;
     if (timeValuePair.second) {
       if (VALUEPOINT == timeValuePair.second->GetType()) {
-        oldValue = new Point(static_cast<Value<Point> * >(timeValuePair.second)->GetValue());
+        oldValue = new Point(timeValuePair.second->GetPoint());
       }
-      delete timeValuePair.second;
     }
 #endif
 
-    AbstractValue *value = writePeriodListIterator->GetValueCopy();
+    std::shared_ptr<const AbstractValue> value = writePeriodListIterator->GetValue().GetSharedValue();
     WriteStatus status;
-    stateVariableMapIterator->second.WriteWithRollback(writePeriodListIterator->GetAgent(), value,
+    fKeptReadCount += stateVariable->WriteWithRollback(writePeriodListIterator->GetAgent(), value,
                                                        writePeriodListIterator->GetStartTime(), status, pRollbackList);
 
 #ifdef RANGE_QUERIES
     Point *newValue = NULL;
     if (value) {
       if (VALUEPOINT == value->GetType()) {
-        newValue = new Point(static_cast<const Value<Point> * >(value)->GetValue());
+        newValue = new Point(static_cast<const Value<Point> * >(value.get())->GetValue());
       }
     }
+    if (status == writeSUCCESS) {
+      if (newValue) fPointGrid.Add(pSSVID.id(), *newValue);
+      fPointBounds->Replace(oldValue, newValue, writePeriodListIterator->GetStartTime(),
+                           stateVariable->GetNextStartTime(writePeriodListIterator->GetStartTime()));
+    }
     if (oldValue || newValue) {
       Range *newRange = RecalculateRange(writePeriodListIterator->GetStartTime());
       fRangeRoutingTable->Update(oldValue, newValue, writePeriodListIterator->GetStartTime(), newRange, this,
@@ -89,9 +180,9 @@ void SharedState::Insert(const SsvId &pSSVID, const StateVariable &pStateVariabl
     if (oldValue) delete oldValue;
     if (newValue) delete newValue;
 #endif
-    if (value) delete value;
     ++writePeriodListIterator;
   }
+  AddToTotals(*stateVariable);
 
 #ifdef SSV_LOCALISATION
   fAccessCostCalculator->InitialiseCounters(pSSVID);
@@ -99,11 +190,16 @@ void SharedState::Insert(const SsvId &pSSVID, const StateVariable &pStateVariabl
 }
 
 void SharedState::Delete(const SsvId &pSSVID) {
-  if (!ContainsVariable(pSSVID)) {
+  StateVariable *stateVariable = fStateVariableMap.Find(pSSVID.id());
+  if (stateVariable == NULL) {
     LOG(logERROR) << "SharedState::Delete# trying to delete a variable that does not exists";
     exit(1);
   }
-  fStateVariableMap.erase(pSSVID);
+  RemoveFromTotals(*stateVariable);
+#ifdef RANGE_QUERIES
+  RemovePoints(*stateVariable);
+#endif
+  fStateVariableMap.Erase(pSSVID.id());
 #ifdef SSV_LOCALISATION
   fAccessCostCalculator->RemoveSsvAccessRecord(pSSVID);
   fAccessCostCalculator->RemoveSsvHopRecord(pSSVID);
@@ -112,58 +208,68 @@ void SharedState::Delete(const SsvId &pSSVID) {
 }
 
 StateVariable SharedState::GetCopy(const SsvId &pSSVID) {
-  if (!ContainsVariable(pSSVID)) {
+  const StateVariable *stateVariable = fStateVariableMap.Find(pSSVID.id());
+  if (stateVariable == NULL) {
     LOG(logERROR) << "SharedState::Get# Trying to get a non-existant variable!";
     exit(1);
   }
-  return StateVariable(fStateVariableMap.find(pSSVID)->second);
+  return StateVariable(*stateVariable);
 }
 
-AbstractValue *SharedState::Read(const SsvId &pSSVID, const LpId &pAgentID, unsigned long pTime) {
-  if (!ContainsVariable(pSSVID)) {
+std::shared_ptr<const AbstractValue> SharedState::Read(const SsvId &pSSVID, const LpId &pAgentID, unsigned long pTime) {
+  StateVariable *stateVariable = fStateVariableMap.Find(pSSVID.id());
+  if (stateVariable == NULL) {
     spdlog::critical(
         "SharedState::SendReadMessageAndGetResponse# trying to perform a read on state variable that doesn't exist, id {}",
         pSSVID.id());
     exit(1);
   }
-  return fStateVariableMap.find(pSSVID)->second.Read(pAgentID, pTime);
+  return stateVariable->Read(pAgentID, pTime);
 }
 
-void SharedState::WriteWithRollback(const SsvId &pSSVID, const LpId &pAgentID, const AbstractValue *pNewValue,
-                                    unsigned long pTime, WriteStatus &pWriteStatus, RollbackList &pRollbackList) {
-  if (!ContainsVariable(pSSVID)) {
+void SharedState::WriteWithRollback(const SsvId &pSSVID, const LpId &pAgentID,
+                                    const std::shared_ptr<const AbstractValue> &pNewValue, unsigned long pTime,
+                                    WriteStatus &pWriteStatus, RollbackList &pRollbackList) {
+  StateVariable *stateVariable = fStateVariableMap.Find(pSSVID.id());
+  if (stateVariable == NULL) {
     spdlog::critical(
         "SharedState::WriteWithRollback# Trying to perform a write on state variable that doesn't exist, id {}",
         pSSVID.id());
     exit(1);
   }
-  map<SsvId, StateVariable>::iterator stateVariableMapIterator = fStateVariableMap.find(pSSVID);
 #ifdef RANGE_QUERIES
-  pair<unsigned long, AbstractValue *> timeValuePair = stateVariableMapIterator->second.ReadWithoutRecord(pTime);
+  pair<unsigned long, const StoredValue *> timeValuePair = stateVariable->ReadWithoutRecord(pTime);
   unsigned long endTime = timeValuePair.first;
   Point *oldValue = NULL;
   if (timeValuePair.second) {
     if (VALUEPOINT == timeValuePair.second->GetType()) {
-      oldValue = new Point(static_cast<Value<Point> * >(timeValuePair.second)->GetValue());
+      oldValue = new Point(timeValuePair.second->GetPoint());
     }
-    delete timeValuePair.second;
   }
 #endif
 
-  stateVariableMapIterator->second.WriteWithRollback(pAgentID, pNewValue, pTime, pWriteStatus, pRollbackList);
+  RemoveFromTotals(*stateVariable);
+  fKeptReadCount += stateVariable->WriteWithRollback(pAgentID, pNewValue, pTime, pWriteStatus, pRollbackList);
+  AddToTotals(*stateVariable);
 
 #ifdef RANGE_QUERIES
   Point *newValue = NULL;
   if (pNewValue) {
     if (VALUEPOINT == pNewValue->GetType()) {
-      newValue = new Point(static_cast<const Value<Point> * >(pNewValue)->GetValue());
+      newValue = new Point(static_cast<const Value<Point> * >(pNewValue.get())->GetValue());
     }
   }
+  if (pWriteStatus == writeSUCCESS && newValue) fPointGrid.Add(pSSVID.id(), *newValue);
+  if (fShardMutex) fShardMutex->Lock();
+  if (pWriteStatus == writeSUCCESS) {
+    fPointBounds->Replace(oldValue, newValue, pTime, stateVariable->GetNextStartTime(pTime));
+  }
   if (oldValue || newValue) {
     Range *newRange = RecalculateRange(pTime);
     fRangeRoutingTable->Update(oldValue, newValue, pTime, newRange, this, pRollbackList, endTime);
     if (newRange) delete newRange;
   }
+  if (fShardMutex) fShardMutex->Unlock();
   if (oldValue) delete oldValue;
   if (newValue) delete newValue;
 #endif
@@ -172,23 +278,39 @@ void SharedState::WriteWithRollback(const SsvId &pSSVID, const LpId &pAgentID, c
 SerialisableMap<SsvId, Value<Point> >
 SharedState::RangeRead(const Range &pRange, Direction pDirection, unsigned long pHops, unsigned long pTime) {
   SerialisableMap<SsvId, Value<Point> > pointMap;
-  map<SsvId, StateVariable>::iterator stateVariableIterator = fStateVariableMap.begin();
+#ifdef RANGE_QUERIES
+  // Only the variables with a write period in a cell of the range can have a value in it
+  vector<unsigned long> candidates;
+  fPointGrid.FindCandidates(pRange, candidates);
+  for (unsigned long candidate : candidates) {
+    const StateVariable *stateVariable = fStateVariableMap.Find(candidate);
+    pair<unsigned long, const StoredValue *> timeValuePair = stateVariable->ReadWithoutRecord(pTime);
+    if (timeValuePair.second) {
+      if (VALUEPOINT == timeValuePair.second->GetType()) {
+        Point point = timeValuePair.second->GetPoint();
+        if (pRange.IsValueOverlapping(point)) {
+          pointMap.insert(make_pair(stateVariable->GetVariableId(), Value<Point>(point)));
+          UpdateAccessCount(stateVariable->GetVariableId(), pDirection, pHops);
+        }
+      }
+    }
+  }
+#else
+  IdHashMap<StateVariable>::iterator stateVariableIterator = fStateVariableMap.begin();
   while (stateVariableIterator != fStateVariableMap.end()) {
-    pair<unsigned long, AbstractValue *> timeValuePair = stateVariableIterator->second.ReadWithoutRecord(pTime);
+    pair<unsigned long, const StoredValue *> timeValuePair = stateVariableIterator->ReadWithoutRecord(pTime);
     if (timeValuePair.second) {
       if (VALUEPOINT == timeValuePair.second->GetType()) {
-        Value<Point> *pointValue = static_cast<Value<Point> * >(timeValuePair.second);
-        if (pRange.IsValueOverlapping(pointValue->GetValue())) {
-          pointMap.insert(make_pair(stateVariableIterator->first, *pointValue));
-          UpdateAccessCount(stateVariableIterator->first, pDirection, pHops);
+        Point point = timeValuePair.second->GetPoint();
+        if (pRange.IsValueOverlapping(point)) {
+          pointMap.insert(make_pair(stateVariableIterator->GetVariableId(), Value<Point>(point)));
+          UpdateAccessCount(stateVariableIterator->GetVariableId(), pDirection, pHops);
         }
       }
-      delete timeValuePair.second;
     }
     ++stateVariableIterator;
   }
-  int rank;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
 
 //  spdlog::debug("clp {0}, time {1}, rangeread(({2},{3})-({4},{5}), {6})",
 //                rank, pTime,
@@ -200,20 +322,22 @@ SharedState::RangeRead(const Range &pRange, Direction pDirection, unsigned long
 }
 
 Range *SharedState::RecalculateRange(unsigned long pTime) const {
-  map<SsvId, StateVariable>::const_iterator stateVariableIterator = fStateVariableMap.begin();
+#ifdef RANGE_QUERIES
+  return fPointBounds->GetRange(pTime);
+#else
+  IdHashMap<StateVariable>::const_iterator stateVariableIterator = fStateVariableMap.begin();
   Point *minimumPoint = NULL;
   Point *maximumPoint = NULL;
   while (stateVariableIterator != fStateVariableMap.end()) {
-    pair<unsigned long, AbstractValue *> timeValuePair = stateVariableIterator->second.ReadWithoutRecord(pTime);
+    pair<unsigned long, const StoredValue *> timeValuePair = stateVariableIterator->ReadWithoutRecord(pTime);
     if (timeValuePair.second) {
       if (VALUEPOINT == timeValuePair.second->GetType()) {
-        Value<Point> *pointValue = static_cast<Value<Point> * >(timeValuePair.second);
-        if (minimumPoint == NULL) minimumPoint = new Point(pointValue->GetValue());
-        else minimumPoint->Min(pointValue->GetValue());
-        if (maximumPoint == NULL) maximumPoint = new Point(pointValue->GetValue());
-        else maximumPoint->Max(pointValue->GetValue());
+        Point point = timeValuePair.second->GetPoint();
+        if (minimumPoint == NULL) minimumPoint = new Point(point);
+        else minimumPoint->Min(point);
+        if (maximumPoint == NULL) maximumPoint = new Point(point);
+        else maximumPoint->Max(point);
       }
-      delete timeValuePair.second;
     }
     ++stateVariableIterator;
   }
@@ -224,96 +348,128 @@ Range *SharedState::RecalculateRange(unsigned long pTime) const {
     return newRange;
   }
   return NULL;
+#endif
 }
 
 void SharedState::RollbackWrite(const SsvId &pSSVID, const LpId &pAgentID, unsigned long pTime,
                                 RollbackList &pRollbackList) {
-  if (!ContainsVariable(pSSVID)) {
+  StateVariable *stateVariable = fStateVariableMap.Find(pSSVID.id());
+  if (stateVariable == NULL) {
     LOG(logERROR) << "SharedState::RollbackWrite# trying to perform a rollback on statevariable that doesn't exist";
     exit(1);
   }
-  map<SsvId, StateVariable>::iterator stateVariableMapIterator = fStateVariableMap.find(pSSVID);
 #ifdef RANGE_QUERIES
-  pair<unsigned long, AbstractValue *> timeValuePair = stateVariableMapIterator->second.ReadWithoutRecord(pTime);
+  pair<unsigned long, const StoredValue *> timeValuePair = stateVariable->ReadWithoutRecord(pTime);
   unsigned long endTime = timeValuePair.first;
   Point *oldValue = NULL;
   if (timeValuePair.second) {
     if (VALUEPOINT == timeValuePair.second->GetType()) {
-      oldValue = new Point(static_cast<Value<Point> * >(timeValuePair.second)->GetValue());
+      oldValue = new Point(timeValuePair.second->GetPoint());
     }
-    delete timeValuePair.second;
   }
+  Point *erasedValue = GetPointStartingAt(*stateVariable, pTime);
+  unsigned long versionCount = stateVariable->GetVersionCount();
 #endif
 
-  stateVariableMapIterator->second.PerformWriteRollback(pAgentID, pTime, pRollbackList);
+  RemoveFromTotals(*stateVariable);
+  fKeptReadCount += stateVariable->PerformWriteRollback(pAgentID, pTime, pRollbackList);
+  AddToTotals(*stateVariable);
 
 #ifdef RANGE_QUERIES
-  timeValuePair = stateVariableMapIterator->second.ReadWithoutRecord(pTime);
+  bool isErased = stateVariable->GetVersionCount() < versionCount;
+  if (erasedValue) {
+    if (isErased) fPointGrid.Remove(pSSVID.id(), *erasedValue);
+    delete erasedValue;
+  }
+  timeValuePair = stateVariable->ReadWithoutRecord(pTime);
   Point *newValue = NULL;
   if (timeValuePair.second) {
     if (VALUEPOINT == timeValuePair.second->GetType()) {
-      newValue = new Point(static_cast<const Value<Point> * >(timeValuePair.second)->GetValue());
+      newValue = new Point(timeValuePair.second->GetPoint());
     }
-    delete timeValuePair.second;
   }
+  // The variable has the value of the write period before the erased one until the next write period
+  if (fShardMutex) fShardMutex->Lock();
+  if (isErased) fPointBounds->Replace(oldValue, newValue, pTime, stateVariable->GetNextStartTime(pTime));
   if (oldValue || newValue) {
     Range *newRange = RecalculateRange(pTime);
     fRangeRoutingTable->Update(oldValue, newValue, pTime, newRange, this, pRollbackList, endTime);
     if (newRange) delete newRange;
   }
+  if (fShardMutex) fShardMutex->Unlock();
   if (oldValue) delete oldValue;
   if (newValue) delete newValue;
 #endif
 }
 
 void SharedState::RollbackRead(const SsvId &pSSVID, const LpId &pAgentID, unsigned long pTime) {
-  if (!ContainsVariable(pSSVID)) {
+  StateVariable *stateVariable = fStateVariableMap.Find(pSSVID.id());
+  if (stateVariable == NULL) {
     LOG(logERROR) << "SharedState::RollbackRead# trying to perform a rollback on statevariable that doesn't exist";
     exit(1);
   }
-  fStateVariableMap.find(pSSVID)->second.PerformReadRollback(pAgentID, pTime);
+  stateVariable->PerformReadRollback(pAgentID, pTime);
 }
 
 void SharedState::RemoveWritePeriods(unsigned long pTime) {
-  map<SsvId, StateVariable>::iterator stateVariableMapIterator = fStateVariableMap.begin();
+  IdHashMap<StateVariable>::iterator stateVariableMapIterator = fStateVariableMap.begin();
   while (stateVariableMapIterator != fStateVariableMap.end()) {
-    stateVariableMapIterator->second.RemoveWritePeriods(pTime);
+    RemoveFromTotals(*stateVariableMapIterator);
+#ifdef RANGE_QUERIES
+    RemoveFromPointGridBefore(*stateVariableMapIterator, pTime);
+#endif
+    stateVariableMapIterator->RemoveWritePeriods(pTime);
+    AddToTotals(*stateVariableMapIterator);
     ++stateVariableMapIterator;
   }
+#ifdef RANGE_QUERIES
+  fPointBounds->RemoveBefore(pTime);
+#endif
 }
 
 void SharedState::RemoveWritePeriodList(const SsvId &pSSVID, RollbackList &pRollbackList) {
-  if (!ContainsVariable(pSSVID)) {
+  StateVariable *stateVariable = fStateVariableMap.Find(pSSVID.id());
+  if (stateVariable == NULL) {
     LOG(logERROR) << "SharedState::RemoveWritePeriodList# Trying to remove write period list for non-existing SSV";
     exit(1);
   }
-  map<SsvId, StateVariable>::iterator stateVariableMapIterator = fStateVariableMap.find(pSSVID);
-  SerialisableList<WritePeriod> writePeriodList = stateVariableMapIterator->second.GetWritePeriodList();
-  list<WritePeriod>::iterator writePeriodListIterator = writePeriodList.begin();
+  SerialisableDeque<WritePeriod> writePeriodList = stateVariable->GetWritePeriodList();
+  deque<WritePeriod>::iterator writePeriodListIterator = writePeriodList.begin();
   while (writePeriodListIterator != writePeriodList.end()) {
 #ifdef RANGE_QUERIES
-    pair<unsigned long, AbstractValue *> timeValuePair = stateVariableMapIterator->second.ReadWithoutRecord(
+    pair<unsigned long, const StoredValue *> timeValuePair = stateVariable->ReadWithoutRecord(
         writePeriodListIterator->GetStartTime());
     Point *oldValue = NULL;
     if (timeValuePair.second) {
       if (VALUEPOINT == timeValuePair.second->GetType()) {
-        oldValue = new Point(static_cast<Value<Point> * >(timeValuePair.second)->GetValue());
+        oldValue = new Point(timeValuePair.second->GetPoint());
       }
-      delete timeValuePair.second;
     }
+    Point *erasedValue = GetPointStartingAt(*stateVariable, writePeriodListIterator->GetStartTime());
+    unsigned long versionCount = stateVariable->GetVersionCount();
 #endif
 
-    stateVariableMapIterator->second.PerformWriteRollback(writePeriodListIterator->GetAgent(),
+    RemoveFromTotals(*stateVariable);
+    fKeptReadCount += stateVariable->PerformWriteRollback(writePeriodListIterator->GetAgent(),
                                                           writePeriodListIterator->GetStartTime(), pRollbackList);
+    AddToTotals(*stateVariable);
 
 #ifdef RANGE_QUERIES
-    timeValuePair = stateVariableMapIterator->second.ReadWithoutRecord(writePeriodListIterator->GetStartTime());
+    bool isErased = stateVariable->GetVersionCount() < versionCount;
+    if (erasedValue) {
+      if (isErased) fPointGrid.Remove(pSSVID.id(), *erasedValue);
+      delete erasedValue;
+    }
+    timeValuePair = stateVariable->ReadWithoutRecord(writePeriodListIterator->GetStartTime());
     Point *newValue = NULL;
     if (timeValuePair.second) {
       if (VALUEPOINT == timeValuePair.second->GetType()) {
-        newValue = new Point(static_cast<const Value<Point> * >(timeValuePair.second)->GetValue());
+        newValue = new Point(timeValuePair.second->GetPoint());
       }
-      delete timeValuePair.second;
+    }
+    if (isErased) {
+      fPointBounds->Replace(oldValue, newValue, writePeriodListIterator->GetStartTime(),
+                           stateVariable->GetNextStartTime(writePeriodListIterator->GetStartTime()));
     }
     if (oldValue || newValue) {
       Range *newRange = RecalculateRange(writePeriodListIterator->GetStartTime());
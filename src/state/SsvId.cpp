@@ -41,6 +41,14 @@ void SsvId::Deserialise(istream &pIstream) {
   IgnoreTo(pIstream, DELIM_RIGHT);
 }
 
+void SsvId::Pack(WireWriter &pWriter) const {
+  pWriter << id_;
+}
+
+void SsvId::Unpack(WireReader &pReader) {
+  pReader >> id_;
+}
+
 unsigned long SsvId::id() const {
   return id_;
 }
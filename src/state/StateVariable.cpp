@@ -1,15 +1,37 @@
 #include "StateVariable.h"
+#include <algorithm>
 #include <climits>
 #include "spdlog/spdlog.h"
 
 using namespace pdesmas;
 
+static bool IsBeforeStartTime(unsigned long pTime, const WritePeriod &pWritePeriod) {
+  return pTime < pWritePeriod.GetStartTime();
+}
+
+static bool HasStartTimeBefore(const WritePeriod &pWritePeriod, unsigned long pTime) {
+  return pWritePeriod.GetStartTime() < pTime;
+}
+
+// Last write period starting at or before the time, pEnd if there is none
+template<class Iterator>
+static Iterator FindWritePeriod(Iterator pBegin, Iterator pEnd, unsigned long pTime) {
+  if (pBegin == pEnd) return pEnd;
+  // Most reads and writes are at the newest write period
+  Iterator writePeriodIterator = pEnd - 1;
+  if (writePeriodIterator->GetStartTime() <= pTime) return writePeriodIterator;
+  writePeriodIterator = upper_bound(pBegin, pEnd, pTime, IsBeforeStartTime);
+  if (writePeriodIterator == pBegin) return pEnd;
+  return --writePeriodIterator;
+}
+
 StateVariable::StateVariable() {
-  // Empty
+  fValueSize = 0;
 }
 
 StateVariable::StateVariable(const SsvId &pSSVID) {
   fStateVariableID = pSSVID;
+  fValueSize = 0;
 }
 
 StateVariable::StateVariable(const StateVariable &pStateVariable) {
@@ -17,6 +39,7 @@ StateVariable::StateVariable(const StateVariable &pStateVariable) {
   fStateVariableID = SsvId(pStateVariable.fStateVariableID);
   // Copy the write period list, assignment also copies elements
   fWritePeriodList = pStateVariable.fWritePeriodList;
+  fValueSize = pStateVariable.fValueSize;
 }
 
 StateVariable::~StateVariable() {
@@ -27,47 +50,53 @@ const SsvId &StateVariable::GetVariableId() const {
   return fStateVariableID;
 }
 
-const SerialisableList<WritePeriod> &StateVariable::GetWritePeriodList() const {
+const SerialisableDeque<WritePeriod> &StateVariable::GetWritePeriodList() const {
   return fWritePeriodList;
 }
 
+unsigned long StateVariable::GetValueSize() const {
+  return fValueSize;
+}
+
+unsigned long StateVariable::GetVersionCount() const {
+  return fWritePeriodList.size();
+}
+
+void StateVariable::RecalculateValueSize() {
+  fValueSize = 0;
+  for (const WritePeriod &writePeriod : fWritePeriodList) {
+    fValueSize += writePeriod.GetValueSize();
+  }
+}
+
 void StateVariable::AddWritePeriod(const AbstractValue *pValue, unsigned long pTime, const LpId &pAgentID) {
   fWritePeriodList.push_back(WritePeriod(pValue, pTime, pAgentID));
+  fValueSize += fWritePeriodList.back().GetValueSize();
 }
 
 void StateVariable::RemoveWritePeriods(unsigned long pTime) {
   LOG(logFINEST) << "StateVariable::RemoveWritePeriods# Remove write periods up to: " << pTime;
-  int sumlen = 0;
-  for (auto i:fWritePeriodList) {
-    int len = i.GetValueCopy()->GetValueString().length();
-    sumlen += len;
-  }
-  spdlog::warn("LOGMEM ssv {} time {} LEN {}", this->fStateVariableID.id(), pTime, sumlen);
-  SerialisableList<WritePeriod>::reverse_iterator reverseWritePeriodIterator = fWritePeriodList.rbegin();
-  // Walk backwards to the list until the reach the write period with an equal or less than start time then the parameter time
-  while (reverseWritePeriodIterator != fWritePeriodList.rend()) {
-    if (reverseWritePeriodIterator->GetStartTime() <= pTime) break;
-    ++reverseWritePeriodIterator; //Not this one so check next in list
-  }
+  // Find the write period with an equal or less than start time then the parameter time
+  SerialisableDeque<WritePeriod>::iterator writePeriodIterator = FindWritePeriod(fWritePeriodList.begin(),
+                                                                                 fWritePeriodList.end(), pTime);
   // If we've found the write period in the list
-  if ((reverseWritePeriodIterator != fWritePeriodList.rend())) {
-    LOG(logFINEST) << "StateVariable::RemoveWritePeriods# Found write period: " << *reverseWritePeriodIterator;
+  if (writePeriodIterator != fWritePeriodList.end()) {
+    LOG(logFINEST) << "StateVariable::RemoveWritePeriods# Found write period: " << *writePeriodIterator;
     // Set the new start time
-    reverseWritePeriodIterator->SetStartTime(pTime);
+    writePeriodIterator->SetStartTime(pTime);
     LOG(logFINEST) << "StateVariable::RemoveWritePeriods# Reset start time to: " << pTime << ", writeperiod: "
-                   << *reverseWritePeriodIterator;
+                   << *writePeriodIterator;
     // Remove all reads from before the time
-    reverseWritePeriodIterator->RemoveReadsBefore(pTime);
-    // Remove all write periods up to the downward write period iterator
-    SerialisableList<WritePeriod>::iterator writePeriodIterator = fWritePeriodList.begin();
-    while (writePeriodIterator->GetStartTime() != reverseWritePeriodIterator->GetStartTime()) {
-      LOG(logFINEST) << "StateVariable::RemoveWritePeriods# Erase write period: " << *writePeriodIterator;
-      writePeriodIterator = fWritePeriodList.erase(writePeriodIterator);
-      if (writePeriodIterator == fWritePeriodList.end()) break;
+    writePeriodIterator->RemoveReadsBefore(pTime);
+    // Remove all write periods before the found one
+    for (SerialisableDeque<WritePeriod>::iterator erasedIterator = fWritePeriodList.begin();
+         erasedIterator != writePeriodIterator; ++erasedIterator) {
+      fValueSize -= erasedIterator->GetValueSize();
     }
+    fWritePeriodList.erase(fWritePeriodList.begin(), writePeriodIterator);
   }
   LOG(logFINEST) << "StateVariable::RemoveWritePeriods# Remaining write period list: ";
-  for (SerialisableList<WritePeriod>::iterator writePeriodIterator =
+  for (SerialisableDeque<WritePeriod>::iterator writePeriodIterator =
       fWritePeriodList.begin(); writePeriodIterator != fWritePeriodList.end(); ++writePeriodIterator) {
     LOG(logFINEST)
       << "StateVariable::RemoveWritePeriod# " << *writePeriodIterator;
@@ -75,19 +104,15 @@ void StateVariable::RemoveWritePeriods(unsigned long pTime) {
   LOG(logFINEST) << "StateVariable::RemoveWritePeriods# End of write period list.";
 }
 
-AbstractValue *StateVariable::Read(const LpId &pReadingAgent, unsigned long pTime) {
-  SerialisableList<WritePeriod>::reverse_iterator
-      reverseWritePeriodIterator = fWritePeriodList.rbegin();
-  while (reverseWritePeriodIterator != fWritePeriodList.rend()) {
-    if (reverseWritePeriodIterator->GetStartTime() <= pTime) break;
-    ++reverseWritePeriodIterator; //Not this one so check next in list
-  }
-  if (reverseWritePeriodIterator == fWritePeriodList.rend()) {
+std::shared_ptr<const AbstractValue> StateVariable::Read(const LpId &pReadingAgent, unsigned long pTime) {
+  SerialisableDeque<WritePeriod>::iterator writePeriodIterator = FindWritePeriod(fWritePeriodList.begin(),
+                                                                                 fWritePeriodList.end(), pTime);
+  if (writePeriodIterator == fWritePeriodList.end()) {
     spdlog::critical(
         "StateVariable::Read: Could not find a write period, id: {}, reading agent: {}, time: {}",
         fStateVariableID.id(), pReadingAgent.GetId(), pTime);
 
-    for (SerialisableList<WritePeriod>::iterator writePeriodIterator =
+    for (SerialisableDeque<WritePeriod>::iterator writePeriodIterator =
         fWritePeriodList.begin(); writePeriodIterator != fWritePeriodList.end(); ++writePeriodIterator) {
       ostringstream out;
       writePeriodIterator->Serialise(out);
@@ -97,119 +122,115 @@ AbstractValue *StateVariable::Read(const LpId &pReadingAgent, unsigned long pTim
     exit(1);
   }
   //SendReadMessageAndGetResponse the write period
-  return reverseWritePeriodIterator->Read(pReadingAgent, pTime);
+  return writePeriodIterator->Read(pReadingAgent, pTime);
 }
 
-pair<unsigned long, AbstractValue *> StateVariable::ReadWithoutRecord(unsigned long pTime) const {
-  SerialisableList<WritePeriod>::const_reverse_iterator reverseWritePeriodIterator = fWritePeriodList.rbegin();
-  while (reverseWritePeriodIterator != fWritePeriodList.rend()) {
-    if (reverseWritePeriodIterator->GetStartTime() <= pTime) break;
-    ++reverseWritePeriodIterator; //Not this one so check next in list
+pair<unsigned long, const StoredValue *> StateVariable::ReadWithoutRecord(unsigned long pTime) const {
+  SerialisableDeque<WritePeriod>::const_iterator writePeriodIterator = FindWritePeriod(fWritePeriodList.begin(),
+                                                                                       fWritePeriodList.end(), pTime);
+  if (writePeriodIterator != fWritePeriodList.end()) {
+    const StoredValue *value = writePeriodIterator->GetValue().IsEmpty() ? NULL : &writePeriodIterator->GetValue();
+    return make_pair(writePeriodIterator->GetEndTime(), value);
   }
-  //Add to readlist of write period
-  if (reverseWritePeriodIterator != fWritePeriodList.rend()) {
-    return make_pair(reverseWritePeriodIterator->GetEndTime(), reverseWritePeriodIterator->GetValueCopy());
-  }
-  AbstractValue *value = NULL;
+  const StoredValue *value = NULL;
   return make_pair(ULONG_MAX, value);
 }
 
-void StateVariable::WriteWithRollback(const LpId &pWritingAgent, const AbstractValue *pValue, unsigned long pTime,
-                                      WriteStatus &pWriteStatus, RollbackList &pRollbackList) {
+const WritePeriod *StateVariable::FindWritePeriodStartingAt(unsigned long pTime) const {
+  SerialisableDeque<WritePeriod>::const_iterator writePeriodIterator = lower_bound(fWritePeriodList.begin(),
+                                                                                   fWritePeriodList.end(), pTime,
+                                                                                   HasStartTimeBefore);
+  if (writePeriodIterator == fWritePeriodList.end() || writePeriodIterator->GetStartTime() != pTime) return NULL;
+  return &*writePeriodIterator;
+}
+
+unsigned long StateVariable::GetNextStartTime(unsigned long pTime) const {
+  SerialisableDeque<WritePeriod>::const_iterator writePeriodIterator = upper_bound(fWritePeriodList.begin(),
+                                                                                   fWritePeriodList.end(), pTime,
+                                                                                   IsBeforeStartTime);
+  return (writePeriodIterator == fWritePeriodList.end()) ? ULONG_MAX : writePeriodIterator->GetStartTime();
+}
+
+unsigned long StateVariable::WriteWithRollback(const LpId &pWritingAgent,
+                                               const std::shared_ptr<const AbstractValue> &pValue, unsigned long pTime,
+                                               WriteStatus &pWriteStatus, RollbackList &pRollbackList) {
   // Create the new write period
   WritePeriod newWritePeriod(pValue, pTime, pWritingAgent);
+  unsigned long newValueSize = newWritePeriod.GetValueSize();
   // If the list is empty, just pushback the new write period
   if (fWritePeriodList.empty()) {
-    fWritePeriodList.push_back(newWritePeriod);
+    fWritePeriodList.push_back(std::move(newWritePeriod));
     pWriteStatus = writeSUCCESS;
-    int sumlen = 0;
-    for (auto i:fWritePeriodList) {
-      int len = i.GetValueCopy()->GetValueString().length();
-      sumlen += len;
-    }
-    spdlog::warn("LOGMEM ssv {} time {} LEN {}", this->fStateVariableID.id(), pTime, sumlen);
-    return;
-  }
-  // The list is not empty, so reverse walk to write period just before new write period in time
-  auto reverseWritePeriodIterator = fWritePeriodList.rbegin();
-  while (reverseWritePeriodIterator != fWritePeriodList.rend()) {
-    if (reverseWritePeriodIterator->GetStartTime() <= pTime) break;
-    ++reverseWritePeriodIterator; //Not this one so check next in list
+    fValueSize += newValueSize;
+    return 0;
   }
-  // Walked through the entire list and didn't find a 'before' write period!
-  if (reverseWritePeriodIterator == fWritePeriodList.rend()) {
+  // The list is not empty, so find the write period just before new write period in time
+  SerialisableDeque<WritePeriod>::iterator writePeriodIterator = FindWritePeriod(fWritePeriodList.begin(),
+                                                                                 fWritePeriodList.end(), pTime);
+  // Didn't find a 'before' write period!
+  if (writePeriodIterator == fWritePeriodList.end()) {
     LOG(logWARNING)
       << "StateVariable::WriteWithRollback# Didn't find before write period, writing agent: "
       << pWritingAgent << ", value: " << pValue << ",                           time: " << pTime
       << ", write status: " << pWriteStatus;
     pWriteStatus = writeFAILURE;
-    return;
+    return 0;
   }
   // Reject any write at the same time from different agents (using a tie-breaker)
-  if (reverseWritePeriodIterator->GetStartTime() == pTime
-      && reverseWritePeriodIterator->GetAgent() > pWritingAgent) {
+  if (writePeriodIterator->GetStartTime() == pTime
+      && writePeriodIterator->GetAgent() > pWritingAgent) {
     spdlog::debug("StateVariable::WriteWithRollback# Write failed! (writing at same time)");
     pWriteStatus = writeFAILURE;
-    return;
+    return 0;
   }
   // Set end time for write period in the list
-  reverseWritePeriodIterator->SetEndTime(newWritePeriod.GetStartTime());
+  writePeriodIterator->SetEndTime(newWritePeriod.GetStartTime());
+  unsigned long keptReadCount = 0;
+#ifdef LAZY_CANCELLATION
+  // The reads after time still see the same value, they move to the new write period
+  if (writePeriodIterator->GetValue().IsEqual(newWritePeriod.GetValue())) {
+    keptReadCount = writePeriodIterator->MoveReadsAfterInclusive(pTime, newWritePeriod);
+  }
+#endif
   // Get rollback list for all invalidated reads after time
-  reverseWritePeriodIterator->RemoveReadsAfterInclusive(pTime, pRollbackList);
+  writePeriodIterator->RemoveReadsAfterInclusive(pTime, pRollbackList);
   // If there is a write period ahead (we split a write period), set end time for new write period
-  if (reverseWritePeriodIterator != fWritePeriodList.rbegin()) {
-    // Move iterator one to the right
-    --reverseWritePeriodIterator;
-    newWritePeriod.SetEndTime(reverseWritePeriodIterator->GetStartTime());
-    // Move iterator one to the left
-    ++reverseWritePeriodIterator;
-    // Insert write period just before the just moved iterator (base reverse iterator point to one to the right)
-    fWritePeriodList.insert(reverseWritePeriodIterator.base(), newWritePeriod);
+  ++writePeriodIterator;
+  if (writePeriodIterator != fWritePeriodList.end()) {
+    newWritePeriod.SetEndTime(writePeriodIterator->GetStartTime());
+    // Insert write period just before the write period ahead
+    fWritePeriodList.insert(writePeriodIterator, std::move(newWritePeriod));
     pWriteStatus = writeSUCCESS;
-    int sumlen = 0;
-    for (auto i:fWritePeriodList) {
-      int len = i.GetValueCopy()->GetValueString().length();
-      sumlen += len;
-    }
-    spdlog::warn("LOGMEM ssv {} time {} LEN {}", this->fStateVariableID.id(), pTime, sumlen);
-    return;
+    fValueSize += newValueSize;
+    return keptReadCount;
   }
   // We have not split a write period, so we can append the new write period to the list
-  fWritePeriodList.push_back(newWritePeriod);
+  fWritePeriodList.push_back(std::move(newWritePeriod));
   pWriteStatus = writeSUCCESS;
-  int sumlen = 0;
-  for (auto i:fWritePeriodList) {
-    int len = i.GetValueCopy()->GetValueString().length();
-    sumlen += len;
-  }
-  spdlog::warn("LOGMEM ssv {} time {} LEN {}", this->fStateVariableID.id(), pTime, sumlen);
+  fValueSize += newValueSize;
+  return keptReadCount;
 }
 
 void StateVariable::PerformReadRollback(const LpId &pWritingAgent, unsigned long pTime) {
-  SerialisableList<WritePeriod>::reverse_iterator reverseWritePeriodIterator = fWritePeriodList.rbegin();
-  while (reverseWritePeriodIterator != fWritePeriodList.rend()) {
-    if (reverseWritePeriodIterator->GetStartTime() <= pTime) break;
-    ++reverseWritePeriodIterator; //Not this one so check next in list
-  }
-  reverseWritePeriodIterator->RemoveReadsByAgent(pWritingAgent, pTime);
+  SerialisableDeque<WritePeriod>::iterator writePeriodIterator = FindWritePeriod(fWritePeriodList.begin(),
+                                                                                 fWritePeriodList.end(), pTime);
+  if (writePeriodIterator != fWritePeriodList.end()) writePeriodIterator->RemoveReadsByAgent(pWritingAgent, pTime);
 }
 
-void StateVariable::PerformWriteRollback(const LpId &pWritingAgent, unsigned long pTime, RollbackList &pRollbackList) {
-  // Walk through write period list to look for write period to roll back
-  SerialisableList<WritePeriod>::iterator writePeriodIterator =
-      fWritePeriodList.begin();
-  while (writePeriodIterator != fWritePeriodList.end()) {
-    if (writePeriodIterator->GetStartTime() == pTime) break;
-    ++writePeriodIterator;
-  }
+unsigned long StateVariable::PerformWriteRollback(const LpId &pWritingAgent, unsigned long pTime,
+                                                  RollbackList &pRollbackList) {
+  // Look for the first write period starting at the time to roll back
+  SerialisableDeque<WritePeriod>::iterator writePeriodIterator = lower_bound(fWritePeriodList.begin(),
+                                                                             fWritePeriodList.end(), pTime,
+                                                                             HasStartTimeBefore);
   // If write period is not found print warning and return
-  if (writePeriodIterator == fWritePeriodList.end()) {
+  if (writePeriodIterator == fWritePeriodList.end() || writePeriodIterator->GetStartTime() != pTime) {
     spdlog::warn(
         "StateVariable::PerformWriteRollback# Can't find Write Period for Rollback: {}, at time {}, ignoring this write rollback",
         pWritingAgent.GetId(), pTime);
 
     spdlog::warn("StateVariable::PerformWriteRollback# Write period list:");
-    for (typename SerialisableList<WritePeriod>::iterator i =
+    for (typename SerialisableDeque<WritePeriod>::iterator i =
         fWritePeriodList.begin(); i != fWritePeriodList.end(); ++i) {
       ostringstream out;
       (*i).Serialise(out);
@@ -217,7 +238,7 @@ void StateVariable::PerformWriteRollback(const LpId &pWritingAgent, unsigned lon
     }
     spdlog::warn("StateVariable::PerformWriteRollback# End of write period list.");
 
-    return;
+    return 0;
   }
   // If write period agent is not writing agent, print warning and return
   if (writePeriodIterator->GetAgent() != pWritingAgent) {
@@ -226,10 +247,20 @@ void StateVariable::PerformWriteRollback(const LpId &pWritingAgent, unsigned lon
         "StateVariable::PerformWriteRollback# Rollback attempted by non-owner, writing agent: {}, owner: {}, time: {}",
         pWritingAgent.GetId(), writePeriodIterator->GetAgent().GetId(), pTime);
 
-    return;
+    return 0;
+  }
+  unsigned long keptReadCount = 0;
+#ifdef LAZY_CANCELLATION
+  // The value of the previous write period becomes visible again, if it is the same the reads move over to it
+  if (writePeriodIterator != fWritePeriodList.begin()
+      && (writePeriodIterator - 1)->GetValue().IsEqual(writePeriodIterator->GetValue())) {
+    keptReadCount = writePeriodIterator->MoveAllReads(*(writePeriodIterator - 1));
   }
+#endif
   // Add all reads to rollback list
   writePeriodIterator->RemoveAllReads(pTime, pRollbackList);
+  // Every case below erases the write period
+  fValueSize -= writePeriodIterator->GetValueSize();
   // If element is the only one in the list
   if (fWritePeriodList.size() == 1) {
     LOG(logFINEST)
@@ -239,10 +270,10 @@ void StateVariable::PerformWriteRollback(const LpId &pWritingAgent, unsigned lon
     // Erase the existing write period
     fWritePeriodList.erase(writePeriodIterator);
     // Return rollback list
-    return;
+    return keptReadCount;
   }
   // If element is last in the list
-  if (writePeriodIterator == (++fWritePeriodList.rbegin()).base()) {
+  if (writePeriodIterator + 1 == fWritePeriodList.end()) {
     // Move iterator to previous one
     --writePeriodIterator;
     // Set previous write period end time to infinite
@@ -252,7 +283,7 @@ void StateVariable::PerformWriteRollback(const LpId &pWritingAgent, unsigned lon
     // Erase the existing write period
     fWritePeriodList.erase(writePeriodIterator);
     // Return rollback list
-    return;
+    return keptReadCount;
   }
   // If element is first in the list
   if (writePeriodIterator == fWritePeriodList.begin()) {
@@ -271,7 +302,7 @@ void StateVariable::PerformWriteRollback(const LpId &pWritingAgent, unsigned lon
     // Erase the existing write period
     fWritePeriodList.erase(writePeriodIterator);
     // Return rollback list
-    return;
+    return keptReadCount;
   }
   // Element is in the middle of the list
   LOG(logFINEST)
@@ -289,7 +320,7 @@ void StateVariable::PerformWriteRollback(const LpId &pWritingAgent, unsigned lon
   // Erase the existing write period
   fWritePeriodList.erase(writePeriodIterator);
   // Return rollback list
-  return;
+  return keptReadCount;
 }
 
 void StateVariable::Serialise(ostream &pOstream) const {
@@ -304,4 +335,14 @@ void StateVariable::Deserialise(istream &pIstream) {
   IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
   pIstream >> fWritePeriodList;
   IgnoreTo(pIstream, DELIM_RIGHT);
+  RecalculateValueSize();
+}
+
+void StateVariable::Pack(WireWriter &pWriter) const {
+  pWriter << fStateVariableID << fWritePeriodList;
+}
+
+void StateVariable::Unpack(WireReader &pReader) {
+  pReader >> fStateVariableID >> fWritePeriodList;
+  RecalculateValueSize();
 }
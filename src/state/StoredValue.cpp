@@ -0,0 +1,155 @@
+#include "StoredValue.h"
+#include "Value.h"
+#include "ObjectMgr.h"
+
+using namespace pdesmas;
+
+StoredValue::StoredValue() {
+  fHasValue = false;
+  fType = VALUEINT;
+  fData.fLong = 0;
+}
+
+bool StoredValue::IsInline() const {
+  switch (fType) {
+    case VALUEINT :
+    case VALUELONG :
+    case VALUEDOUBLE :
+    case VALUEPOINT :
+      return true;
+    default :
+      return false;
+  }
+}
+
+bool StoredValue::SetInline(const AbstractValue* pValue) {
+  switch (pValue->GetType()) {
+    case VALUEINT :
+      fData.fInt = static_cast<const Value<int>*>(pValue)->GetValue();
+      break;
+    case VALUELONG :
+      fData.fLong = static_cast<const Value<long>*>(pValue)->GetValue();
+      break;
+    case VALUEDOUBLE :
+      fData.fDouble = static_cast<const Value<double>*>(pValue)->GetValue();
+      break;
+    case VALUEPOINT : {
+      const Point& point = static_cast<const Value<Point>*>(pValue)->GetValue();
+      fData.fPoint[0] = point.GetX();
+      fData.fPoint[1] = point.GetY();
+    }
+      break;
+    default :
+      return false;
+  }
+  fType = pValue->GetType();
+  fHasValue = true;
+  fSharedValue.reset();
+  return true;
+}
+
+bool StoredValue::IsEmpty() const {
+  return !fHasValue;
+}
+
+pdesmasType StoredValue::GetType() const {
+  return fType;
+}
+
+void StoredValue::Set(const AbstractValue* pValue) {
+  if (pValue == NULL) {
+    fHasValue = false;
+    fSharedValue.reset();
+    return;
+  }
+  if (SetInline(pValue)) return;
+  fType = pValue->GetType();
+  fHasValue = true;
+  fSharedValue.reset(pValue->Clone());
+}
+
+void StoredValue::Set(const std::shared_ptr<const AbstractValue>& pValue) {
+  if (!pValue) {
+    fHasValue = false;
+    fSharedValue.reset();
+    return;
+  }
+  if (SetInline(pValue.get())) return;
+  fType = pValue->GetType();
+  fHasValue = true;
+  fSharedValue = pValue;
+}
+
+AbstractValue* StoredValue::CreateValue() const {
+  if (!fHasValue) return NULL;
+  switch (fType) {
+    case VALUEINT :
+      return new Value<int>(fData.fInt);
+    case VALUELONG :
+      return new Value<long>(fData.fLong);
+    case VALUEDOUBLE :
+      return new Value<double>(fData.fDouble);
+    case VALUEPOINT :
+      return new Value<Point>(GetPoint());
+    default :
+      return fSharedValue->Clone();
+  }
+}
+
+std::shared_ptr<const AbstractValue> StoredValue::GetSharedValue() const {
+  if (fHasValue && !IsInline()) return fSharedValue;
+  return std::shared_ptr<const AbstractValue>(CreateValue());
+}
+
+Point StoredValue::GetPoint() const {
+  return Point(fData.fPoint[0], fData.fPoint[1]);
+}
+
+unsigned long StoredValue::GetSize() const {
+  if (!fHasValue) return 0;
+  switch (fType) {
+    case VALUEINT :
+      return Helper::string_cast<int>(fData.fInt).length();
+    case VALUELONG :
+      return Helper::string_cast<long>(fData.fLong).length();
+    case VALUEDOUBLE :
+      return Helper::string_cast<double>(fData.fDouble).length();
+    case VALUEPOINT :
+      return Helper::string_cast<Point>(GetPoint()).length();
+    default :
+      return fSharedValue->GetValueString().length();
+  }
+}
+
+bool StoredValue::IsEqual(const StoredValue& pStoredValue) const {
+  if (fHasValue != pStoredValue.fHasValue) return false;
+  if (!fHasValue) return true;
+  if (fType != pStoredValue.fType) return false;
+  switch (fType) {
+    case VALUEINT :
+      return fData.fInt == pStoredValue.fData.fInt;
+    case VALUELONG :
+      return fData.fLong == pStoredValue.fData.fLong;
+    case VALUEDOUBLE :
+      return fData.fDouble == pStoredValue.fData.fDouble;
+    case VALUEPOINT :
+      return fData.fPoint[0] == pStoredValue.fData.fPoint[0] && fData.fPoint[1] == pStoredValue.fData.fPoint[1];
+    default :
+      // Shared by the same write, or written again with the same string
+      return fSharedValue == pStoredValue.fSharedValue
+          || fSharedValue->GetValueString() == pStoredValue.fSharedValue->GetValueString();
+  }
+}
+
+void StoredValue::Serialise(ostream& pOstream) const {
+  pOstream << *GetSharedValue();
+}
+
+void StoredValue::Pack(WireWriter& pWriter) const {
+  PackValue(pWriter, GetSharedValue().get());
+}
+
+void StoredValue::Unpack(WireReader& pReader) {
+  std::shared_ptr<const AbstractValue> value(UnpackValue(pReader));
+  Set(value);
+}
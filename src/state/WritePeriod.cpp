@@ -6,7 +6,6 @@ using namespace pdesmas;
 WritePeriod::WritePeriod() {
   fStartTime = 0;
   fEndTime = ULONG_MAX;
-  fValue = NULL;
   fAgent = LpId(0,0);
 }
 
@@ -18,22 +17,52 @@ WritePeriod::WritePeriod(const AbstractValue* pValue, unsigned long pStartTime,
   fAgent = pAgent;
 }
 
+WritePeriod::WritePeriod(const std::shared_ptr<const AbstractValue>& pValue, unsigned long pStartTime,
+                         const LpId& pAgent) {
+  fStartTime = pStartTime;
+  fEndTime = ULONG_MAX;
+  fValue.Set(pValue);
+  fAgent = pAgent;
+}
+
 WritePeriod::WritePeriod(const WritePeriod& pWritePeriod) {
   fStartTime = pWritePeriod.fStartTime;
   fEndTime = pWritePeriod.fEndTime;
   // Copy the value!
-  SetValue(pWritePeriod.fValue);
+  fValue = pWritePeriod.fValue;
   // Copy the agent!
   fAgent = LpId(pWritePeriod.fAgent);
-  // Deep copy the agent read map, assignment copies elements
-  fAgentReadMap = pWritePeriod.fAgentReadMap;
+  // Copy the read records, assignment copies elements
+  fReadRecordList = pWritePeriod.fReadRecordList;
 }
 
-WritePeriod::~WritePeriod() {
-  if (fValue != NULL) {
-    delete fValue;
-    fValue = NULL;
-  }
+WritePeriod::WritePeriod(WritePeriod&& pWritePeriod) {
+  fStartTime = pWritePeriod.fStartTime;
+  fEndTime = pWritePeriod.fEndTime;
+  fValue = std::move(pWritePeriod.fValue);
+  fAgent = pWritePeriod.fAgent;
+  fReadRecordList.Swap(pWritePeriod.fReadRecordList);
+}
+
+WritePeriod& WritePeriod::operator=(const WritePeriod& pWritePeriod) {
+  if (this == &pWritePeriod) return *this;
+  fStartTime = pWritePeriod.fStartTime;
+  fEndTime = pWritePeriod.fEndTime;
+  // Copy the value!
+  fValue = pWritePeriod.fValue;
+  fAgent = pWritePeriod.fAgent;
+  fReadRecordList = pWritePeriod.fReadRecordList;
+  return *this;
+}
+
+WritePeriod& WritePeriod::operator=(WritePeriod&& pWritePeriod) {
+  if (this == &pWritePeriod) return *this;
+  fStartTime = pWritePeriod.fStartTime;
+  fEndTime = pWritePeriod.fEndTime;
+  fValue = std::move(pWritePeriod.fValue);
+  fAgent = pWritePeriod.fAgent;
+  fReadRecordList.Swap(pWritePeriod.fReadRecordList);
+  return *this;
 }
 
 void WritePeriod::SetStartTime(unsigned long pTime) {
@@ -64,61 +93,57 @@ void WritePeriod::SetValue(const AbstractValue* pValue) {
   if (pValue == NULL) {
     return;
   }
-  fValue = pValue->Clone();
+  fValue.Set(pValue);
 }
 
 AbstractValue* WritePeriod::GetValueCopy() const {
-  if (fValue == NULL)
-    return NULL;
-  return fValue->Clone();
+  return fValue.CreateValue();
 }
 
-AbstractValue* WritePeriod::Read(const LpId& pAgent, unsigned long pTime) {
-  fAgentReadMap.insert(make_pair(pAgent, pTime));
-  return GetValueCopy();
+const StoredValue& WritePeriod::GetValue() const {
+  return fValue;
+}
+
+unsigned long WritePeriod::GetValueSize() const {
+  return fValue.GetSize();
+}
+
+std::shared_ptr<const AbstractValue> WritePeriod::Read(const LpId& pAgent, unsigned long pTime) {
+  fReadRecordList.Add(pAgent, pTime);
+  return fValue.GetSharedValue();
 }
 
 void WritePeriod::RemoveReadsBefore(unsigned long pTime) {
-  SerialisableMultiMap<LpId, unsigned long>::iterator agentReadMapIterator = fAgentReadMap.begin();
-  while (agentReadMapIterator != fAgentReadMap.end()) {
-    if (agentReadMapIterator->second < pTime) fAgentReadMap.erase(agentReadMapIterator++);
-    else ++agentReadMapIterator;
-  }
+  fReadRecordList.RemoveBefore(pTime);
 }
 
 void WritePeriod::RemoveReadsAfterInclusive(unsigned long pTime, RollbackList& pRollbackList) {
-  SerialisableMultiMap<LpId, unsigned long>::iterator agentReadMapIterator = fAgentReadMap.begin();
-  while (agentReadMapIterator != fAgentReadMap.end()) {
-    if (agentReadMapIterator->second >= pTime) {
-      pRollbackList.AddLp(agentReadMapIterator->first, agentReadMapIterator->second);
-      fAgentReadMap.erase(agentReadMapIterator++);
-    } else ++agentReadMapIterator;
-  }
+  fReadRecordList.RemoveAfterInclusive(pTime, pRollbackList);
 }
 
 void WritePeriod::RemoveReadsByAgent(const LpId& pAgent, unsigned long pTime) {
-  SerialisableMultiMap<LpId, unsigned long>::iterator agentReadMapIterator = fAgentReadMap.begin();
-  while (agentReadMapIterator != fAgentReadMap.end()) {
-    LpId agent = agentReadMapIterator->first;
-    if (agent == pAgent && agentReadMapIterator->second == pTime) fAgentReadMap.erase(agentReadMapIterator++);
-    else ++agentReadMapIterator;
-  }
+  fReadRecordList.RemoveByAgent(pAgent, pTime);
 }
 
 void WritePeriod::RemoveAllReads(unsigned long pTime, RollbackList& pRollbackList) {
-  SerialisableMultiMap<LpId, unsigned long>::iterator agentReadMapIterator = fAgentReadMap.begin();
-  while (agentReadMapIterator != fAgentReadMap.end()) {
-    pRollbackList.AddLp(agentReadMapIterator->first, pTime);
-    fAgentReadMap.erase(agentReadMapIterator++);
-  }
+  fReadRecordList.RemoveAll(pTime, pRollbackList);
+}
+
+unsigned long WritePeriod::MoveReadsAfterInclusive(unsigned long pTime, WritePeriod& pWritePeriod) {
+  return fReadRecordList.MoveAfterInclusive(pTime, pWritePeriod.fReadRecordList);
+}
+
+unsigned long WritePeriod::MoveAllReads(WritePeriod& pWritePeriod) {
+  return fReadRecordList.MoveAll(pWritePeriod.fReadRecordList);
 }
 
 void WritePeriod::Serialise(ostream& pOstream) const {
   pOstream << DELIM_LEFT << fStartTime;
   pOstream << DELIM_VAR_SEPARATOR << fEndTime;
   pOstream << DELIM_VAR_SEPARATOR << fAgent;
-  pOstream << DELIM_VAR_SEPARATOR << fAgentReadMap;
-  pOstream << DELIM_VAR_SEPARATOR << *fValue;
+  pOstream << DELIM_VAR_SEPARATOR << fReadRecordList;
+  pOstream << DELIM_VAR_SEPARATOR;
+  fValue.Serialise(pOstream);
   pOstream << DELIM_RIGHT;
 }
 
@@ -130,13 +155,25 @@ void WritePeriod::Deserialise(istream& pIstream) {
   IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
   pIstream >> fAgent;
   IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
-  pIstream >> fAgentReadMap;
+  pIstream >> fReadRecordList;
   IgnoreTo(pIstream, DELIM_VAR_SEPARATOR);
   IgnoreTo(pIstream, DELIM_LEFT);
   string valueString;
   getline(pIstream, valueString, DELIM_LIST_RIGHT);
   string value = GetValueString(valueString);
-  fValue = valueClassMap->CreateObject(GetTypeID(valueString));
-  fValue->SetValue(value);
+  AbstractValue* newValue = valueClassMap->CreateObject(GetTypeID(valueString));
+  newValue->SetValue(value);
+  fValue.Set(newValue);
+  delete newValue;
   pIstream.unget();
 }
+
+void WritePeriod::Pack(WireWriter& pWriter) const {
+  pWriter << fStartTime << fEndTime << fAgent << fReadRecordList;
+  fValue.Pack(pWriter);
+}
+
+void WritePeriod::Unpack(WireReader& pReader) {
+  pReader >> fStartTime >> fEndTime >> fAgent >> fReadRecordList;
+  fValue.Unpack(pReader);
+}
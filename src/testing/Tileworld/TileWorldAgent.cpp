@@ -126,11 +126,10 @@ void TileWorldAgent::Cycle() {
     }
 
     if (hole_in_range.empty()) {
-      // random move with tile
-      WritePoint(this->agent_id(), rand_p, this->GetLVT()); // moving to the position
+      // random move with tile, the agent and the tile move together
       spdlog::info("Agent {0}, to ({1},{2}) with tile, LVT {3}", this->agent_id(), rand_p.GetX(), rand_p.GetY(),
                    this->GetLVT());
-      WritePoint(my_tile_ssv_id.id(), rand_p, this->GetLVT());
+      WriteMany<Point>({{this->agent_id(), rand_p}, {my_tile_ssv_id.id(), rand_p}}, this->GetLVT());
       spdlog::info("Agent {0}, dropped tile at ({1},{2}), LVT {3}", this->agent_id(), rand_p.GetX(), rand_p.GetY(),
                    this->GetLVT());
 
@@ -143,10 +142,8 @@ void TileWorldAgent::Cycle() {
         // have tile, move to hole
         WritePrivateInt(IS_TILE_CARRYING, 0);
 
-        WritePoint(this->agent_id(), p, this->GetLVT());
         spdlog::info("Agent {0}, to hole ({1},{2}), LVT {3}", this->agent_id(), p.GetX(), p.GetY(), this->GetLVT());
-
-        WritePoint(my_tile_ssv_id.id(), p, this->GetLVT());
+        WriteMany<Point>({{this->agent_id(), p}, {my_tile_ssv_id.id(), p}}, this->GetLVT());
         spdlog::info("Agent {0}, dropped tile at hole ({1},{2}), LVT {3}", this->agent_id(), p.GetX(), p.GetY(),
                      this->GetLVT());
 
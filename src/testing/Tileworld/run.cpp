@@ -7,17 +7,14 @@
 
 using namespace std;
 using namespace pdesmas;
-int endTime = 1000;
 
-int main(int argc, char **argv) {
-  spdlog::set_level(spdlog::level::debug);
-  spdlog::set_pattern("%f [%P] %+");
+int run(int argc, char **argv) {
   Simulation sim = Simulation();
 
   uint64_t numAgents = std::atoll(argv[1]);
   uint64_t numMPI = std::atoll(argv[2]);
   int randSeed = std::atoi(argv[3]);
-  endTime = std::atoi(argv[4]);
+  int endTime = std::atoi(argv[4]);
 
   const int worldSize = sqrt(numAgents) * 18;
   const uint64_t numTile = numAgents / 4;
@@ -75,4 +72,15 @@ int main(int argc, char **argv) {
   spdlog::info("LP exit, rank {0}", sim.rank());
 
   sim.Finalise();
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  spdlog::set_level(spdlog::level::debug);
+  spdlog::set_pattern("%f [%P] %+");
+  // Optional fifth argument "inprocess": run all LPs as threads of this process instead of one per MPI process
+  if (argc > 5 && string(argv[5]) == "inprocess") {
+    return Simulation::RunInProcess(std::atoi(argv[2]), run, argc, argv);
+  }
+  return run(argc, argv);
 }
\ No newline at end of file
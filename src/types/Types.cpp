@@ -19,6 +19,13 @@ namespace pdesmas {
         pString.substr(start, end - start));
   }
 
+  extern pdesmasType GetTypeID(const WireReader& pReader) {
+    // The type follows the format version at the start of the message header
+    unsigned char type = 0;
+    pReader.PeekAt(1, &type, sizeof(type));
+    return static_cast<pdesmasType>(type);
+  }
+
   bool IsSimulationMessage(pdesmasType pType) {
     switch (pType) {
       case SINGLEREADMESSAGE:
@@ -39,6 +46,14 @@ namespace pdesmas {
         return true;
       case ROLLBACKMESSAGE:
         return true;
+      case MULTIREADMESSAGE:
+        return true;
+      case MULTIREADRESPONSEMESSAGE:
+        return true;
+      case MULTIWRITEMESSAGE:
+        return true;
+      case MULTIWRITERESPONSEMESSAGE:
+        return true;
       default:
         return false;
     }
@@ -52,6 +67,10 @@ namespace pdesmas {
         return true;
       case RANGEQUERYMESSAGE:
         return true;
+      case MULTIREADMESSAGE:
+        return true;
+      case MULTIWRITEMESSAGE:
+        return true;
       default:
         return false;
     }